@@ -97,8 +97,21 @@ Object.defineProperty(BaseWindow.prototype, 'movable', {
   set: function (move) { this.setMovable(move); }
 });
 
+// Walks the windows without materializing the array getAllWindows() returns,
+// so lookups that stop early do not pay for every window.
+BaseWindow._iterateWindows = function * () {
+  let next = BaseWindow._getNextWindow(0);
+  while (next) {
+    const [window, cursor] = next;
+    yield window;
+    next = BaseWindow._getNextWindow(cursor);
+  }
+};
+
 BaseWindow.getFocusedWindow = () => {
-  return BaseWindow.getAllWindows().find((win) => win.isFocused());
+  for (const win of BaseWindow._iterateWindows()) {
+    if (win.isFocused()) return win;
+  }
 };
 
 module.exports = BaseWindow;
@@ -85,8 +85,10 @@ BrowserWindow.getAllWindows = () => {
 };
 
 BrowserWindow.getFocusedWindow = () => {
-  for (const window of BrowserWindow.getAllWindows()) {
-    if (window.isFocused() || window.isDevToolsFocused()) return window;
+  for (const window of BaseWindow._iterateWindows()) {
+    if (!isBrowserWindow(window)) continue;
+    const win = window as any as BWT;
+    if (win.isFocused() || win.isDevToolsFocused()) return win;
   }
   return null;
 };
@@ -96,8 +98,10 @@ BrowserWindow.fromWebContents = (webContents: WebContents) => {
 };
 
 BrowserWindow.fromBrowserView = (browserView: BrowserView) => {
-  for (const window of BrowserWindow.getAllWindows()) {
-    if (window.getBrowserView() === browserView) return window;
+  for (const window of BaseWindow._iterateWindows()) {
+    if (!isBrowserWindow(window)) continue;
+    const win = window as any as BWT;
+    if (win.getBrowserView() === browserView) return win;
   }
 
   return null;
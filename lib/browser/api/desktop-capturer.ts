@@ -3,3 +3,8 @@ import { getSourcesImpl } from '@electron/internal/browser/desktop-capturer';
 export async function getSources (options: Electron.SourcesOptions) {
   return getSourcesImpl(null, options);
 }
+
+export async function streamSources (options: Electron.SourcesOptions, listener: (source: Electron.DesktopCapturerSource) => void) {
+  if (typeof listener !== 'function') throw new Error('listener must be a function');
+  return getSourcesImpl(null, options, listener);
+}
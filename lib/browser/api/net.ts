@@ -10,6 +10,9 @@ const {
 
 const kSupportedProtocols = new Set(['http:', 'https:']);
 
+// Keep in sync with kMaxResponseBufferSize in electron_api_url_loader.cc.
+const kMaxResponseBufferSize = 16 * 1024 * 1024;
+
 // set of headers that Node.js discards duplicates for
 // see https://nodejs.org/api/http.html#http_message_headers
 const discardableDuplicateHeaders = new Set([
@@ -245,6 +248,19 @@ function parseOptions (optionsIn: ClientRequestConstructorOptions | string): Nod
     body: null as any,
     useSessionCookies: options.useSessionCookies || false
   };
+  if (options.responseBufferSize != null) {
+    if (!Number.isInteger(options.responseBufferSize) || options.responseBufferSize < 0 ||
+        options.responseBufferSize > kMaxResponseBufferSize) {
+      throw new TypeError(`\`responseBufferSize\` should be an integer between 0 and ${kMaxResponseBufferSize}`);
+    }
+    urlLoaderOptions.responseBufferSize = options.responseBufferSize;
+  }
+  if (options.savePath != null) {
+    if (typeof options.savePath !== 'string') {
+      throw new TypeError('`savePath` should be a string');
+    }
+    urlLoaderOptions.savePath = options.savePath;
+  }
   for (const [name, value] of Object.entries(urlLoaderOptions.extraHeaders!)) {
     if (!isValidHeaderName(name)) {
       throw new Error(`Invalid header name: '${name}'`);
@@ -396,14 +412,18 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
       return ret;
     };
     this._urlLoaderOptions.referrer = this._urlLoaderOptions.extraHeaders.referer || '';
-    const opts = { ...this._urlLoaderOptions, extraHeaders: stringifyValues(this._urlLoaderOptions.extraHeaders) };
+    // Requests are loaded off the main thread unless a 'redirect' handler may
+    // need to stop a redirect before it is followed.
+    const loadOnUIThread = this._redirectPolicy === 'follow' && this.listenerCount('redirect') > 0;
+    const opts = { ...this._urlLoaderOptions, redirectPolicy: this._redirectPolicy, loadOnUIThread, extraHeaders: stringifyValues(this._urlLoaderOptions.extraHeaders) };
     this._urlLoader = createURLLoader(opts);
     this._urlLoader.on('response-started', (event, finalUrl, responseHead) => {
       const response = this._response = new IncomingMessage(responseHead);
       this.emit('response', response);
     });
     this._urlLoader.on('data', (event, data) => {
-      this._response!._storeInternalData(Buffer.from(data));
+      // Share the memory of the chunk instead of copying it.
+      this._response!._storeInternalData(Buffer.from(data.buffer, data.byteOffset, data.byteLength));
     });
     this._urlLoader.on('complete', () => {
       if (this._response) { this._response._storeInternalData(null); }
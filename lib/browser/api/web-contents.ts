@@ -675,3 +675,7 @@ export function getFocusedWebContents () {
 export function getAllWebContents () {
   return binding.getAllWebContents();
 }
+
+export function capturePages (requests: Electron.CapturePageRequest[]) {
+  return binding.capturePages(requests);
+}
@@ -13,7 +13,7 @@ function isValid (options: Electron.SourcesOptions) {
   return Array.isArray(types);
 }
 
-export const getSourcesImpl = (event: Electron.IpcMainEvent | null, args: Electron.SourcesOptions) => {
+export const getSourcesImpl = (event: Electron.IpcMainEvent | null, args: Electron.SourcesOptions, onSource?: (source: Electron.DesktopCapturerSource) => void) => {
   if (!isValid(args)) throw new Error('Invalid options');
 
   const captureWindow = args.types.includes('window');
@@ -29,11 +29,15 @@ export const getSourcesImpl = (event: Electron.IpcMainEvent | null, args: Electr
     fetchWindowIcons
   };
 
-  for (const running of currentlyRunning) {
-    if (deepEqual(running.options, options)) {
-      // If a request is currently running for the same options
-      // return that promise
-      return running.getSources;
+  // Streaming requests need their own capturer to deliver sources to
+  // |onSource|, so they never share a running request.
+  if (!onSource) {
+    for (const running of currentlyRunning) {
+      if (deepEqual(running.options, options)) {
+        // If a request is currently running for the same options
+        // return that promise
+        return running.getSources;
+      }
     }
   }
 
@@ -44,6 +48,7 @@ export const getSourcesImpl = (event: Electron.IpcMainEvent | null, args: Electr
       if (capturer) {
         delete capturer._onerror;
         delete capturer._onfinished;
+        delete capturer._onsource;
         capturer = null;
       }
       // Remove from currentlyRunning once we resolve or reject
@@ -60,7 +65,11 @@ export const getSourcesImpl = (event: Electron.IpcMainEvent | null, args: Electr
       resolve(sources);
     };
 
-    capturer.startHandling(captureWindow, captureScreen, thumbnailSize, fetchWindowIcons);
+    if (onSource) {
+      capturer._onsource = onSource;
+    }
+
+    capturer.startHandling(captureWindow, captureScreen, thumbnailSize, fetchWindowIcons, !!onSource);
 
     // If the WebContents is destroyed before receiving result, just remove the
     // reference to emit and the capturer itself so that it never dispatches
@@ -70,10 +79,12 @@ export const getSourcesImpl = (event: Electron.IpcMainEvent | null, args: Electr
     }
   });
 
-  currentlyRunning.push({
-    options,
-    getSources
-  });
+  if (!onSource) {
+    currentlyRunning.push({
+      options,
+      getSources
+    });
+  }
 
   return getSources;
 };
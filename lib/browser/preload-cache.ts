@@ -0,0 +1,78 @@
+import * as crypto from 'crypto';
+import * as fs from 'fs';
+import * as v8 from 'v8';
+import * as vm from 'vm';
+
+// Parameters of the function preload scripts of sandboxed renderers are
+// compiled as, keep in sync with CompilePreloadScript() in
+// shell/renderer/electron_sandboxed_renderer_client.cc.
+const wrapperParams = ['require', 'process', 'Buffer', 'global', 'setImmediate', 'clearImmediate', 'exports'];
+
+// Code caches are only valid for the V8 version and flags they were produced
+// with, which this tag identifies.
+const browserVersionTag = v8.cachedDataVersionTag();
+
+interface PreloadCacheEntry {
+  mtimeMs: number;
+  size: number;
+  hash: string;
+  source: string;
+  cachedData?: Buffer;
+  cacheRequested?: boolean;
+}
+
+const cache = new Map<string, PreloadCacheEntry>();
+
+const produceCachedData = function (entry: PreloadCacheEntry) {
+  try {
+    const fn = vm.compileFunction(entry.source, wrapperParams, { produceCachedData: true }) as any;
+    if (fn.cachedDataProduced) {
+      entry.cachedData = fn.cachedData;
+    }
+  } catch {
+    // Errors are reported by the renderer when it compiles the script.
+  }
+};
+
+const getEntry = async function (preloadPath: string, produceCache: boolean) {
+  const { mtimeMs, size } = await fs.promises.stat(preloadPath);
+  let entry = cache.get(preloadPath);
+  if (!entry || entry.mtimeMs !== mtimeMs || entry.size !== size) {
+    const source = (await fs.promises.readFile(preloadPath)).toString();
+    const hash = crypto.createHash('sha256').update(source).digest('hex');
+
+    if (entry && entry.hash === hash) {
+      // Touching the file without changing it keeps the code cache.
+      entry.mtimeMs = mtimeMs;
+      entry.size = size;
+    } else {
+      entry = { mtimeMs, size, hash, source };
+      cache.set(preloadPath, entry);
+    }
+  }
+
+  // The renderer asking for the script compiles it itself, so generate the
+  // code cache for later renderers once this request has been answered.
+  // Caches are only ever produced here and never taken from renderers, so a
+  // compromised renderer cannot plant code in the others.
+  if (produceCache && !entry.cacheRequested) {
+    entry.cacheRequested = true;
+    const target = entry;
+    setImmediate(() => produceCachedData(target));
+  }
+  return entry;
+};
+
+// |versionTag| is the renderer's CachedDataVersionTag. Renderers whose V8
+// flags differ from the browser's would reject its code cache, so they are
+// given none and no cache is produced for them.
+export const getPreloadScript = async function (preloadPath: string, versionTag: number) {
+  try {
+    const useCache = versionTag === browserVersionTag;
+    const { source, cachedData } = await getEntry(preloadPath, useCache);
+    return { preloadPath, preloadSrc: source, cachedData: useCache ? cachedData : undefined, preloadError: null };
+  } catch (error) {
+    cache.delete(preloadPath);
+    return { preloadPath, preloadSrc: null, preloadError: error };
+  }
+};
@@ -4,20 +4,16 @@ import { WebContents } from 'electron/main';
 
 const v8Util = process._linkedBinding('electron_common_v8_util');
 
-const getOwnerKey = (webContents: WebContents, contextId: string) => {
-  return `${webContents.id}-${contextId}`;
-};
-
 class ObjectsRegistry {
   private nextId: number = 0
 
   // Stores all objects by ref-counting.
   // (id) => {object, count}
-  private storage: Record<number, { count: number, object: any }> = {}
+  private storage = new Map<number, { count: number, object: any }>()
 
   // Stores the IDs + refCounts of objects referenced by WebContents.
-  // (ownerKey) => { id: refCount }
-  private owners: Record<string, Map<number, number>> = {}
+  // (webContentsId) => (contextId) => { id: refCount }
+  private owners = new Map<number, Map<string, Map<number, number>>>()
 
   // Register a new object and return its assigned ID. If the object is already
   // registered then the already assigned ID would be returned.
@@ -26,25 +22,30 @@ class ObjectsRegistry {
     const id = this.saveToStorage(obj);
 
     // Add object to the set of referenced objects.
-    const ownerKey = getOwnerKey(webContents, contextId);
-    let owner = this.owners[ownerKey];
+    let contexts = this.owners.get(webContents.id);
+    if (!contexts) {
+      contexts = new Map();
+      this.owners.set(webContents.id, contexts);
+    }
+    let owner = contexts.get(contextId);
     if (!owner) {
-      owner = this.owners[ownerKey] = new Map();
+      owner = new Map();
+      contexts.set(contextId, owner);
       this.registerDeleteListener(webContents, contextId);
     }
-    if (!owner.has(id)) {
-      owner.set(id, 0);
+    const refCount = owner.get(id);
+    if (refCount === undefined) {
       // Increase reference count if not referenced before.
-      this.storage[id].count++;
+      this.storage.get(id)!.count++;
     }
 
-    owner.set(id, owner.get(id)! + 1);
+    owner.set(id, (refCount || 0) + 1);
     return id;
   }
 
   // Get an object according to its ID.
   get (id: number) {
-    const pointer = this.storage[id];
+    const pointer = this.storage.get(id);
     if (pointer != null) return pointer.object;
   }
 
@@ -52,10 +53,10 @@ class ObjectsRegistry {
   // Note that an object may be double-freed (cleared when page is reloaded, and
   // then garbage collected in old page).
   remove (webContents: WebContents, contextId: string, id: number) {
-    const ownerKey = getOwnerKey(webContents, contextId);
-    const owner = this.owners[ownerKey];
-    if (owner && owner.has(id)) {
-      const newRefCount = owner.get(id)! - 1;
+    const owner = this.getOwner(webContents, contextId);
+    const refCount = owner && owner.get(id);
+    if (owner && refCount !== undefined) {
+      const newRefCount = refCount - 1;
 
       // Only completely remove if the number of references GCed in the
       // renderer is the same as the number of references we sent them
@@ -72,13 +73,20 @@ class ObjectsRegistry {
 
   // Clear all references to objects refrenced by the WebContents.
   clear (webContents: WebContents, contextId: string) {
-    const ownerKey = getOwnerKey(webContents, contextId);
-    const owner = this.owners[ownerKey];
-    if (!owner) return;
+    const contexts = this.owners.get(webContents.id);
+    const owner = contexts && contexts.get(contextId);
+    if (!contexts || !owner) return;
 
     for (const id of owner.keys()) this.dereference(id);
 
-    delete this.owners[ownerKey];
+    contexts.delete(contextId);
+    if (contexts.size === 0) this.owners.delete(webContents.id);
+  }
+
+  // Private: Returns the refCounts of objects referenced by the context.
+  getOwner (webContents: WebContents, contextId: string) {
+    const contexts = this.owners.get(webContents.id);
+    return contexts && contexts.get(contextId);
   }
 
   // Private: Saves the object into storage and assigns an ID for it.
@@ -86,10 +94,10 @@ class ObjectsRegistry {
     let id: number = v8Util.getHiddenValue(object, 'electronId');
     if (!id) {
       id = ++this.nextId;
-      this.storage[id] = {
+      this.storage.set(id, {
         count: 0,
         object: object
-      };
+      });
       v8Util.setHiddenValue(object, 'electronId', id);
     }
     return id;
@@ -97,14 +105,14 @@ class ObjectsRegistry {
 
   // Private: Dereference the object from store.
   dereference (id: number) {
-    const pointer = this.storage[id];
+    const pointer = this.storage.get(id);
     if (pointer == null) {
       return;
     }
     pointer.count -= 1;
     if (pointer.count === 0) {
       v8Util.deleteHiddenValue(pointer.object, 'electronId');
-      delete this.storage[id];
+      this.storage.delete(id);
     }
   }
 
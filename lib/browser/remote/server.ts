@@ -85,8 +85,17 @@ const getObjectMembers = function (object: any): ObjectMember[] {
 const getObjectPrototype = function (object: any): ObjProtoDescriptor {
   const proto = Object.getPrototypeOf(object);
   if (proto === null || proto === Object.prototype) return null;
+
+  // The members of a frozen prototype can never change, so they are only
+  // described once. Any other prototype may have been changed since it was
+  // last described, which can't be told without reflecting on it again.
+  let members: ObjectMember[] = v8Util.getHiddenValue(proto, 'remoteMembers');
+  if (!members) {
+    members = getObjectMembers(proto);
+    if (Object.isFrozen(proto)) v8Util.setHiddenValue(proto, 'remoteMembers', members);
+  }
   return {
-    members: getObjectMembers(proto),
+    members,
     proto: getObjectPrototype(proto)
   };
 };
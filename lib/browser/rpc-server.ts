@@ -1,10 +1,10 @@
 import { app } from 'electron/main';
 import type { IpcMainInvokeEvent, WebContents } from 'electron/main';
 import { clipboard, crashReporter, nativeImage } from 'electron/common';
-import * as fs from 'fs';
 import { ipcMainInternal } from '@electron/internal/browser/ipc-main-internal';
 import * as ipcMainUtils from '@electron/internal/browser/ipc-main-internal-utils';
 import * as guestViewManager from '@electron/internal/browser/guest-view-manager';
+import { getPreloadScript } from '@electron/internal/browser/preload-cache';
 import * as typeUtils from '@electron/internal/common/type-utils';
 
 const eventBinding = process._linkedBinding('electron_browser_event');
@@ -77,23 +77,12 @@ const isRemoteModuleEnabled = BUILDFLAG(ENABLE_REMOTE_MODULE)
   ? require('@electron/internal/browser/remote/server').isRemoteModuleEnabled
   : () => false;
 
-const getPreloadScript = async function (preloadPath: string) {
-  let preloadSrc = null;
-  let preloadError = null;
-  try {
-    preloadSrc = (await fs.promises.readFile(preloadPath)).toString();
-  } catch (error) {
-    preloadError = error;
-  }
-  return { preloadPath, preloadSrc, preloadError };
-};
-
-ipcMainUtils.handleSync('ELECTRON_BROWSER_SANDBOX_LOAD', async function (event: IpcMainInvokeEvent) {
+ipcMainUtils.handleSync('ELECTRON_BROWSER_SANDBOX_LOAD', async function (event: IpcMainInvokeEvent, versionTag: number) {
   const preloadPaths = event.sender._getPreloadPaths();
   const webPreferences = event.sender.getLastWebPreferences() || {};
 
   return {
-    preloadScripts: await Promise.all(preloadPaths.map(path => getPreloadScript(path))),
+    preloadScripts: await Promise.all(preloadPaths.map(path => getPreloadScript(path, versionTag))),
     isRemoteModuleEnabled: isRemoteModuleEnabled(event.sender),
     isWebViewTagEnabled: guestViewManager.isWebViewTagEnabled(event.sender),
     guestInstanceId: webPreferences.guestInstanceId,
@@ -113,6 +102,10 @@ ipcMainInternal.on('ELECTRON_BROWSER_PRELOAD_ERROR', function (event: ElectronIn
   event.sender.emit('preload-error', event, preloadPath, error);
 });
 
+ipcMainInternal.on('ELECTRON_BROWSER_PRELOAD_EXECUTED', function (event: ElectronInternal.IpcMainInternalEvent, preloadPath: string, details: Electron.PreloadExecutedDetails) {
+  event.sender.emit('preload-executed', event, preloadPath, details);
+});
+
 ipcMainUtils.handleSync('ELECTRON_CRASH_REPORTER_GET_LAST_CRASH_REPORT', () => {
   return crashReporter.getLastCrashReport();
 });
@@ -29,7 +29,7 @@ const {
   guestInstanceId,
   openerId,
   process: processProps
-} = ipcRendererUtils.invokeSync('ELECTRON_BROWSER_SANDBOX_LOAD');
+} = ipcRendererUtils.invokeSync('ELECTRON_BROWSER_SANDBOX_LOAD', binding.cachedDataVersionTag);
 
 process.isRemoteModuleEnabled = isRemoteModuleEnabled;
 
@@ -150,29 +150,35 @@ if (process.isMainFrame) {
   webViewInit(contextIsolation, isWebViewTagEnabled, guestInstanceId);
 }
 
-// Wrap the script into a function executed in global scope. It won't have
+// Compile the script into a function executed in global scope. It won't have
 // access to the current scope, so we'll expose a few objects as arguments:
 //
 // - `require`: The `preloadRequire` function
 // - `process`: The `preloadProcess` object
 // - `Buffer`: Shim of `Buffer` implementation
 // - `global`: The window object, which is aliased to `global` by webpack.
-function runPreloadScript (preloadSrc: string) {
-  const preloadWrapperSrc = `(function(require, process, Buffer, global, setImmediate, clearImmediate, exports) {
-  ${preloadSrc}
-  })`;
-
-  // eval in window scope
-  const preloadFn = binding.createPreloadScript(preloadWrapperSrc);
+function runPreloadScript (preloadPath: string, preloadSrc: string, cachedData?: Uint8Array) {
+  const compileStart = performance.now();
+  const { fn: preloadFn, cachedDataRejected } = binding.compilePreloadScript(preloadPath, preloadSrc, cachedData);
+  const executeStart = performance.now();
   const { setImmediate, clearImmediate } = require('timers');
 
   preloadFn(preloadRequire, preloadProcess, Buffer, global, setImmediate, clearImmediate, {});
+
+  const executeEnd = performance.now();
+  const details: Electron.PreloadExecutedDetails = {
+    compileTime: executeStart - compileStart,
+    executionTime: executeEnd - executeStart,
+    elapsedTime: executeEnd,
+    codeCache: cachedData ? (cachedDataRejected ? 'rejected' : 'accepted') : 'none'
+  };
+  ipcRendererInternal.send('ELECTRON_BROWSER_PRELOAD_EXECUTED', preloadPath, details);
 }
 
-for (const { preloadPath, preloadSrc, preloadError } of preloadScripts) {
+for (const { preloadPath, preloadSrc, cachedData, preloadError } of preloadScripts) {
   try {
     if (preloadSrc) {
-      runPreloadScript(preloadSrc);
+      runPreloadScript(preloadPath, preloadSrc, cachedData);
     } else if (preloadError) {
       throw preloadError;
     }
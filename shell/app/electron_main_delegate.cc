@@ -7,6 +7,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <utility>
 
 #if defined(OS_LINUX)
 #include <glib.h>  // for g_setenv()
@@ -15,7 +16,9 @@
 #include "base/command_line.h"
 #include "base/debug/stack_trace.h"
 #include "base/environment.h"
+#include "base/files/file.h"
 #include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/logging.h"
 #include "base/mac/bundle_locations.h"
 #include "base/path_service.h"
@@ -25,6 +28,7 @@
 #include "content/public/common/content_switches.h"
 #include "electron/buildflags/buildflags.h"
 #include "extensions/common/constants.h"
+#include "gin/v8_initializer.h"
 #include "ipc/ipc_buildflags.h"
 #include "sandbox/policy/switches.h"
 #include "services/service_manager/embedder/switches.h"
@@ -42,6 +46,7 @@
 #include "ui/base/l10n/l10n_util.h"
 #include "ui/base/resource/resource_bundle.h"
 #include "ui/base/ui_base_switches.h"
+#include "v8/include/v8.h"
 
 #if defined(OS_MAC)
 #include "shell/app/electron_main_delegate_mac.h"
@@ -55,7 +60,6 @@
 #if defined(OS_LINUX)
 #include "components/crash/core/app/breakpad_linux.h"
 #include "v8/include/v8-wasm-trap-handler-posix.h"
-#include "v8/include/v8.h"
 #endif
 
 #if !defined(MAS_BUILD)
@@ -112,6 +116,46 @@ void InvalidParameterHandler(const wchar_t*,
 }
 #endif
 
+#if defined(V8_USE_EXTERNAL_STARTUP_DATA)
+// Whether |file| holds a snapshot built for this V8 version. V8 would abort
+// on any other snapshot, so a stale one left by an update must be skipped.
+bool IsValidSnapshot(const base::File& file) {
+  base::MemoryMappedFile mapped;
+  if (!mapped.Initialize(file.Duplicate()) || mapped.length() == 0)
+    return false;
+  v8::StartupData data = {reinterpret_cast<const char*>(mapped.data()),
+                          static_cast<int>(mapped.length())};
+  return data.IsValid();
+}
+
+// Maps the V8 startup snapshot an app can ship next to its app.asar for the
+// main process, usually built with mksnapshot and an --embed_script holding
+// the app's main process modules. Content loads the default snapshot later
+// during startup, which is a no-op once one has been loaded, and which is
+// what is used when the app's snapshot is invalid.
+void LoadBrowserSnapshot() {
+  base::FilePath path;
+#if defined(OS_MAC)
+  path = base::mac::MainBundlePath().Append("Contents").Append("Resources");
+#else
+  base::PathService::Get(base::DIR_EXE, &path);
+  path = path.Append(FILE_PATH_LITERAL("resources"));
+#endif
+  base::File file(path.Append(FILE_PATH_LITERAL("browser_v8_snapshot.bin")),
+                  base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return;
+  if (!IsValidSnapshot(file)) {
+    LOG(WARNING) << "Ignoring browser_v8_snapshot.bin, it was not built for "
+                    "this version of V8";
+    return;
+  }
+  gin::V8Initializer::LoadV8SnapshotFromFile(
+      std::move(file), nullptr,
+      gin::V8Initializer::V8SnapshotFileType::kDefault);
+}
+#endif
+
 }  // namespace
 
 // TODO(nornagon): move path provider overriding to its own file in
@@ -236,6 +280,11 @@ bool ElectronMainDelegate::BasicStartupComplete(int* exit_code) {
   chrome::RegisterPathProvider();
   electron::RegisterPathProvider();
 
+#if defined(V8_USE_EXTERNAL_STARTUP_DATA)
+  if (IsBrowserProcess(command_line))
+    LoadBrowserSnapshot();
+#endif
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   ContentSettingsPattern::SetNonWildcardDomainNonPortSchemes(
       kNonWildcardDomainNonPortSchemes, kNonWildcardDomainNonPortSchemesSize);
@@ -295,6 +295,11 @@ int NodeMain(int argc, char* argv[]) {
     gin_env.platform()->DrainTasks(isolate);
     gin_env.platform()->CancelPendingDelayedTasks(isolate);
     gin_env.platform()->UnregisterIsolate(isolate);
+
+    // The loop no longer runs, so close the task runner's handles and run it
+    // once more to free them.
+    uv_task_runner->Close();
+    uv_run(loop, UV_RUN_NOWAIT);
   }
 
   // According to "src/gin/shell/gin_main.cc":
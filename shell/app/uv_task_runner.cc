@@ -2,31 +2,71 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <functional>
 #include <utility>
 
 #include "shell/app/uv_task_runner.h"
 
-#include "base/stl_util.h"
+#include "base/memory/scoped_refptr.h"
 
 namespace electron {
 
-UvTaskRunner::UvTaskRunner(uv_loop_t* loop) : loop_(loop) {}
+UvTaskRunner::DelayedTask::DelayedTask(uint64_t deadline,
+                                       uint64_t sequence_num,
+                                       base::OnceClosure task)
+    : deadline(deadline), sequence_num(sequence_num), task(std::move(task)) {}
+UvTaskRunner::DelayedTask::DelayedTask(DelayedTask&&) = default;
+UvTaskRunner::DelayedTask& UvTaskRunner::DelayedTask::operator=(
+    DelayedTask&&) = default;
+UvTaskRunner::DelayedTask::~DelayedTask() = default;
 
-UvTaskRunner::~UvTaskRunner() {
-  for (auto& iter : tasks_) {
-    uv_unref(reinterpret_cast<uv_handle_t*>(iter.first));
-    delete iter.first;
-  }
+bool UvTaskRunner::DelayedTask::operator>(const DelayedTask& other) const {
+  if (deadline != other.deadline)
+    return deadline > other.deadline;
+  return sequence_num > other.sequence_num;
+}
+
+UvTaskRunner::UvTaskRunner(uv_loop_t* loop) : loop_(loop) {
+  uv_idle_init(loop_, idle_.get());
+  idle_.get()->data = this;
+  uv_timer_init(loop_, timer_.get());
+  timer_.get()->data = this;
+}
+
+// Pending tasks are dropped, and the handles are closed by their UvHandle
+// unless Close() already did.
+UvTaskRunner::~UvTaskRunner() = default;
+
+void UvTaskRunner::Close() {
+  // Closed first, so that tasks posted while the dropped ones are destroyed
+  // are refused.
+  idle_.reset();
+  timer_.reset();
+  immediate_tasks_.clear();
+  delayed_tasks_.clear();
 }
 
 bool UvTaskRunner::PostDelayedTask(const base::Location& from_here,
                                    base::OnceClosure task,
                                    base::TimeDelta delay) {
-  auto* timer = new uv_timer_t;
-  timer->data = this;
-  uv_timer_init(loop_, timer);
-  uv_timer_start(timer, UvTaskRunner::OnTimeout, delay.InMilliseconds(), 0);
-  tasks_[timer] = std::move(task);
+  if (!idle_.get())
+    return false;
+
+  int64_t delay_ms = delay.InMilliseconds();
+  if (delay_ms <= 0) {
+    immediate_tasks_.push_back(std::move(task));
+    uv_idle_start(idle_.get(), UvTaskRunner::OnIdle);
+    return true;
+  }
+
+  delayed_tasks_.emplace_back(uv_now(loop_) + delay_ms, next_sequence_num_++,
+                              std::move(task));
+  std::push_heap(delayed_tasks_.begin(), delayed_tasks_.end(),
+                 std::greater<DelayedTask>());
+  // Only a new earliest deadline needs the timer to be re-armed.
+  if (delayed_tasks_.front().sequence_num == next_sequence_num_ - 1)
+    ScheduleTimer();
   return true;
 }
 
@@ -41,21 +81,46 @@ bool UvTaskRunner::PostNonNestableDelayedTask(const base::Location& from_here,
 }
 
 // static
-void UvTaskRunner::OnTimeout(uv_timer_t* timer) {
-  auto& tasks = static_cast<UvTaskRunner*>(timer->data)->tasks_;
-  const auto iter = tasks.find(timer);
-  if (iter == std::end(tasks))
-    return;
+void UvTaskRunner::OnIdle(uv_idle_t* handle) {
+  scoped_refptr<UvTaskRunner> self(static_cast<UvTaskRunner*>(handle->data));
 
-  std::move(iter->second).Run();
-  tasks.erase(iter);
-  uv_timer_stop(timer);
-  uv_close(reinterpret_cast<uv_handle_t*>(timer), UvTaskRunner::OnClose);
+  // Tasks posted while running these wait for the next loop iteration, so
+  // that they can not starve the loop.
+  base::circular_deque<base::OnceClosure> tasks;
+  tasks.swap(self->immediate_tasks_);
+  for (auto& task : tasks)
+    std::move(task).Run();
+
+  if (self->immediate_tasks_.empty())
+    uv_idle_stop(handle);
 }
 
 // static
-void UvTaskRunner::OnClose(uv_handle_t* handle) {
-  delete reinterpret_cast<uv_timer_t*>(handle);
+void UvTaskRunner::OnTimeout(uv_timer_t* handle) {
+  scoped_refptr<UvTaskRunner> self(static_cast<UvTaskRunner*>(handle->data));
+  auto& tasks = self->delayed_tasks_;
+
+  uint64_t now = uv_now(self->loop_);
+  while (!tasks.empty() && tasks.front().deadline <= now) {
+    std::pop_heap(tasks.begin(), tasks.end(), std::greater<DelayedTask>());
+    base::OnceClosure task = std::move(tasks.back().task);
+    tasks.pop_back();
+    std::move(task).Run();
+  }
+
+  self->ScheduleTimer();
+}
+
+void UvTaskRunner::ScheduleTimer() {
+  if (delayed_tasks_.empty()) {
+    uv_timer_stop(timer_.get());
+    return;
+  }
+
+  uint64_t deadline = delayed_tasks_.front().deadline;
+  uint64_t now = uv_now(loop_);
+  uv_timer_start(timer_.get(), UvTaskRunner::OnTimeout,
+                 deadline > now ? deadline - now : 0, 0);
 }
 
 }  // namespace electron
@@ -5,20 +5,31 @@
 #ifndef SHELL_APP_UV_TASK_RUNNER_H_
 #define SHELL_APP_UV_TASK_RUNNER_H_
 
-#include <map>
+#include <vector>
 
 #include "base/callback.h"
+#include "base/containers/circular_deque.h"
 #include "base/location.h"
+#include "base/macros.h"
 #include "base/single_thread_task_runner.h"
+#include "shell/common/uv_handle.h"
 #include "uv.h"  // NOLINT(build/include_directory)
 
 namespace electron {
 
 // TaskRunner implementation that posts tasks into libuv's default loop.
+//
+// Tasks without a delay are queued and run together from a single idle
+// handle, delayed tasks are kept in a min-heap of deadlines served by a
+// single timer armed for the earliest one.
 class UvTaskRunner : public base::SingleThreadTaskRunner {
  public:
   explicit UvTaskRunner(uv_loop_t* loop);
 
+  // Drops pending tasks and closes the handles, after which no more tasks
+  // are accepted. The loop has to run once more to free the handles.
+  void Close();
+
   // base::SingleThreadTaskRunner:
   bool PostDelayedTask(const base::Location& from_here,
                        base::OnceClosure task,
@@ -29,13 +40,39 @@ class UvTaskRunner : public base::SingleThreadTaskRunner {
                                   base::TimeDelta delay) override;
 
  private:
+  struct DelayedTask {
+    DelayedTask(uint64_t deadline,
+                uint64_t sequence_num,
+                base::OnceClosure task);
+    DelayedTask(DelayedTask&&);
+    DelayedTask& operator=(DelayedTask&&);
+    ~DelayedTask();
+
+    // Orders the heap so that the earliest deadline is on top, and tasks
+    // with the same deadline run in the order they were posted.
+    bool operator>(const DelayedTask& other) const;
+
+    // Loop time in milliseconds at which the task is due.
+    uint64_t deadline;
+    uint64_t sequence_num;
+    base::OnceClosure task;
+  };
+
   ~UvTaskRunner() override;
-  static void OnTimeout(uv_timer_t* timer);
-  static void OnClose(uv_handle_t* handle);
+  static void OnIdle(uv_idle_t* handle);
+  static void OnTimeout(uv_timer_t* handle);
+
+  // Arms |timer_| for the earliest delayed task, or stops it.
+  void ScheduleTimer();
 
   uv_loop_t* loop_;
 
-  std::map<uv_timer_t*, base::OnceClosure> tasks_;
+  UvHandle<uv_idle_t> idle_;
+  UvHandle<uv_timer_t> timer_;
+
+  base::circular_deque<base::OnceClosure> immediate_tasks_;
+  std::vector<DelayedTask> delayed_tasks_;
+  uint64_t next_sequence_num_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(UvTaskRunner);
 };
@@ -4,9 +4,11 @@
 
 #include "shell/browser/api/electron_api_app.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/callback_helpers.h"
@@ -17,6 +19,7 @@
 #include "base/optional.h"
 #include "base/path_service.h"
 #include "base/system/sys_info.h"
+#include "base/task/thread_pool.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/icon_manager.h"
 #include "chrome/common/chrome_paths.h"
@@ -37,6 +40,8 @@
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/api/gpuinfo_manager.h"
+#include "shell/browser/api/process_metrics_sampler.h"
+#include "shell/browser/api/spare_web_contents_pool.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/electron_browser_main_parts.h"
 #include "shell/browser/javascript_environment.h"
@@ -53,6 +58,7 @@
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/js_profiler.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
 #include "shell/common/platform_util.h"
@@ -589,6 +595,25 @@ void OnIconDataAvailable(gin_helper::Promise<gfx::Image> promise,
   }
 }
 
+std::unique_ptr<ProcessMetric> CreateProcessMetric(
+    int process_type,
+    base::ProcessHandle handle,
+    const std::string& name = std::string()) {
+  std::unique_ptr<base::ProcessMetrics> metrics;
+  if (base::GetProcId(handle) == base::GetCurrentProcId()) {
+    metrics = base::ProcessMetrics::CreateCurrentProcessMetrics();
+  } else {
+#if defined(OS_MAC)
+    metrics = base::ProcessMetrics::CreateProcessMetrics(
+        handle, content::BrowserChildProcessHost::GetPortProvider());
+#else
+    metrics = base::ProcessMetrics::CreateProcessMetrics(handle);
+#endif
+  }
+  return std::make_unique<ProcessMetric>(process_type, handle,
+                                         std::move(metrics), name);
+}
+
 }  // namespace
 
 App::App() {
@@ -597,10 +622,11 @@ App::App() {
   Browser::Get()->AddObserver(this);
 
   base::ProcessId pid = base::GetCurrentProcId();
-  auto process_metric = std::make_unique<electron::ProcessMetric>(
-      content::PROCESS_TYPE_BROWSER, base::GetCurrentProcessHandle(),
-      base::ProcessMetrics::CreateCurrentProcessMetrics());
-  app_metrics_[pid] = std::move(process_metric);
+  app_metrics_[pid] = CreateProcessMetric(content::PROCESS_TYPE_BROWSER,
+                                          base::GetCurrentProcessHandle());
+#if defined(OS_LINUX)
+  RefreshMemoryInfo();
+#endif
 }
 
 App::~App() {
@@ -628,6 +654,8 @@ void App::OnWindowAllClosed() {
 }
 
 void App::OnQuit() {
+  SpareWebContentsPool::GetInstance()->Clear();
+
   int exitCode = ElectronBrowserMainParts::Get()->GetExitCode();
   Emit("quit", exitCode);
 
@@ -898,20 +926,65 @@ void App::ChildProcessLaunched(int process_type,
                                base::ProcessHandle handle,
                                const std::string& name) {
   auto pid = base::GetProcId(handle);
-
-#if defined(OS_MAC)
-  auto metrics = base::ProcessMetrics::CreateProcessMetrics(
-      handle, content::BrowserChildProcessHost::GetPortProvider());
-#else
-  auto metrics = base::ProcessMetrics::CreateProcessMetrics(handle);
+  app_metrics_[pid] = CreateProcessMetric(process_type, handle, name);
+  if (metrics_sampler_)
+    metrics_sampler_->AddProcess(CreateProcessMetric(process_type, handle, name));
+#if defined(OS_LINUX)
+  RefreshMemoryInfo();
 #endif
-  app_metrics_[pid] = std::make_unique<electron::ProcessMetric>(
-      process_type, handle, std::move(metrics), name);
 }
 
 void App::ChildProcessDisconnected(base::ProcessId pid) {
   app_metrics_.erase(pid);
+  if (metrics_sampler_)
+    metrics_sampler_->RemoveProcess(pid);
+}
+
+#if defined(OS_LINUX)
+void App::RefreshMemoryInfo() {
+  if (memory_refresh_pending_)
+    return;
+  memory_refresh_pending_ = true;
+
+  std::vector<base::ProcessId> pids;
+  pids.reserve(app_metrics_.size());
+  for (const auto& process_metric : app_metrics_)
+    pids.push_back(process_metric.first);
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(
+          [](std::vector<base::ProcessId> pids) {
+            std::vector<std::pair<base::ProcessId, ProcessMemoryInfo>> result;
+            result.reserve(pids.size());
+            for (auto pid : pids)
+              result.emplace_back(pid, ProcessMetric::ReadMemoryInfo(pid));
+            return result;
+          },
+          std::move(pids)),
+      base::BindOnce(&App::OnMemoryInfoRefreshed,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void App::OnMemoryInfoRefreshed(
+    std::vector<std::pair<base::ProcessId, ProcessMemoryInfo>> memory_info) {
+  memory_refresh_pending_ = false;
+  for (auto& entry : memory_info) {
+    auto it = app_metrics_.find(entry.first);
+    // The process may have exited while it was being sampled.
+    if (it == app_metrics_.end())
+      continue;
+    auto& info = entry.second;
+    const auto& previous = it->second->memory_info;
+    info.peak_proportional_set_size = std::max(
+        info.proportional_set_size,
+        previous ? previous->peak_proportional_set_size : size_t{0});
+    it->second->memory_info = info;
+  }
 }
+#endif
 
 base::FilePath App::GetAppPath() const {
   return app_path_;
@@ -1317,6 +1390,11 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   result.reserve(app_metrics_.size());
   int processor_count = base::SysInfo::NumberOfProcessors();
 
+#if defined(OS_LINUX)
+  // Report the last sample and take a fresh one for the next call.
+  RefreshMemoryInfo();
+#endif
+
   for (const auto& process_metric : app_metrics_) {
     gin_helper::Dictionary pid_dict = gin::Dictionary::CreateEmpty(isolate);
     gin_helper::Dictionary cpu_dict = gin::Dictionary::CreateEmpty(isolate);
@@ -1353,26 +1431,46 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
       pid_dict.Set("name", process_metric.second->name);
     }
 
-#if !defined(OS_LINUX)
-    auto memory_info = process_metric.second->GetMemoryInfo();
-
-    gin_helper::Dictionary memory_dict = gin::Dictionary::CreateEmpty(isolate);
-    // TODO(zcbenz): Just call SetHidden when this file is converted to gin.
-    gin_helper::Dictionary(isolate, memory_dict.GetHandle())
-        .SetHidden("simple", true);
-    memory_dict.Set("workingSetSize",
-                    static_cast<double>(memory_info.working_set_size >> 10));
-    memory_dict.Set(
-        "peakWorkingSetSize",
-        static_cast<double>(memory_info.peak_working_set_size >> 10));
+#if defined(OS_LINUX)
+    const auto& memory_info = process_metric.second->memory_info;
+#else
+    base::Optional<ProcessMemoryInfo> memory_info =
+        process_metric.second->GetMemoryInfo();
+#endif
+    if (memory_info) {
+      gin_helper::Dictionary memory_dict =
+          gin::Dictionary::CreateEmpty(isolate);
+      // TODO(zcbenz): Just call SetHidden when this file is converted to gin.
+      gin_helper::Dictionary(isolate, memory_dict.GetHandle())
+          .SetHidden("simple", true);
+      memory_dict.Set("workingSetSize",
+                      static_cast<double>(memory_info->working_set_size >> 10));
+      memory_dict.Set(
+          "peakWorkingSetSize",
+          static_cast<double>(memory_info->peak_working_set_size >> 10));
 
 #if defined(OS_WIN)
-    memory_dict.Set("privateBytes",
-                    static_cast<double>(memory_info.private_bytes >> 10));
+      memory_dict.Set("privateBytes",
+                      static_cast<double>(memory_info->private_bytes >> 10));
+#elif defined(OS_LINUX)
+      // Leave out what could not be read rather than reporting zeros.
+      if (memory_info->has_smaps_rollup) {
+        memory_dict.Set(
+            "proportionalSetSize",
+            static_cast<double>(memory_info->proportional_set_size >> 10));
+        memory_dict.Set(
+            "peakProportionalSetSize",
+            static_cast<double>(memory_info->peak_proportional_set_size >> 10));
+        memory_dict.Set("privateDirty",
+                        static_cast<double>(memory_info->private_dirty >> 10));
+        memory_dict.Set("sharedDirty",
+                        static_cast<double>(memory_info->shared_dirty >> 10));
+      }
+      memory_dict.Set("swap", static_cast<double>(memory_info->swap >> 10));
 #endif
 
-    pid_dict.Set("memory", memory_dict);
-#endif
+      pid_dict.Set("memory", memory_dict);
+    }
 
 #if defined(OS_MAC)
     pid_dict.Set("sandboxed", process_metric.second->IsSandboxed());
@@ -1424,6 +1522,123 @@ v8::Local<v8::Promise> App::GetGPUInfo(v8::Isolate* isolate,
   return handle;
 }
 
+void App::SetSpareRendererPoolSize(gin_helper::ErrorThrower thrower,
+                                   int size,
+                                   gin::Arguments* args) {
+  if (!Browser::Get()->is_ready()) {
+    thrower.ThrowError(
+        "app.setSpareRendererPoolSize() can only be called after app is ready");
+    return;
+  }
+  if (size < 0) {
+    thrower.ThrowError("Pool size must not be negative");
+    return;
+  }
+
+  gin_helper::Dictionary web_preferences =
+      gin::Dictionary::CreateEmpty(args->isolate());
+  args->GetNext(&web_preferences);
+  if (!SpareWebContentsPool::GetInstance()->SetSize(
+          args->isolate(), web_preferences, static_cast<size_t>(size)))
+    thrower.ThrowError("webPreferences with a session can not be pooled");
+}
+
+void App::StartMetricsSampler(gin_helper::ErrorThrower thrower,
+                              gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  args->GetNext(&options);
+  int interval = 1000;
+  int history_size = 60;
+  if (options.Get("interval", &interval) && interval <= 0) {
+    thrower.ThrowError("interval must be positive");
+    return;
+  }
+  if (options.Get("historySize", &history_size) && history_size <= 0) {
+    thrower.ThrowError("historySize must be positive");
+    return;
+  }
+
+  metrics_sampler_ = std::make_unique<ProcessMetricsSampler>(
+      base::TimeDelta::FromMilliseconds(interval),
+      static_cast<size_t>(history_size));
+  for (const auto& process_metric : app_metrics_) {
+    metrics_sampler_->AddProcess(
+        CreateProcessMetric(process_metric.second->type,
+                            process_metric.second->process.Handle(),
+                            process_metric.second->name));
+  }
+}
+
+void App::StopMetricsSampler() {
+  metrics_sampler_.reset();
+}
+
+v8::Local<v8::Value> App::GetMetricsHistory(v8::Isolate* isolate) {
+  if (!metrics_sampler_)
+    return v8::Null(isolate);
+  return metrics_sampler_->GetHistory(isolate);
+}
+
+void App::StartCpuProfiling(gin_helper::ErrorThrower thrower,
+                            gin::Arguments* args) {
+  base::TimeDelta sampling_interval;
+  std::string error;
+  if (!GetCpuProfilingOptions(args, &sampling_interval, &error)) {
+    thrower.ThrowError(error);
+    return;
+  }
+
+  if (!js_profiler_)
+    js_profiler_ = std::make_unique<JsProfiler>(args->isolate());
+  if (!js_profiler_->StartCpuProfiling(sampling_interval))
+    thrower.ThrowError("CPU profiling has already been started");
+}
+
+v8::Local<v8::Value> App::StopCpuProfiling(v8::Isolate* isolate) {
+  base::Optional<std::string> profile;
+  if (js_profiler_)
+    profile = js_profiler_->StopCpuProfiling();
+  if (!profile)
+    return v8::Null(isolate);
+  return gin::StringToV8(isolate, *profile);
+}
+
+void App::StartHeapProfiling(gin_helper::ErrorThrower thrower,
+                             gin::Arguments* args) {
+  uint64_t sampling_interval;
+  int stack_depth;
+  std::string error;
+  if (!GetHeapProfilingOptions(args, &sampling_interval, &stack_depth,
+                               &error)) {
+    thrower.ThrowError(error);
+    return;
+  }
+
+  if (!js_profiler_)
+    js_profiler_ = std::make_unique<JsProfiler>(args->isolate());
+  if (!js_profiler_->StartHeapProfiling(sampling_interval, stack_depth))
+    thrower.ThrowError("Heap profiling has already been started");
+}
+
+v8::Local<v8::Value> App::StopHeapProfiling(v8::Isolate* isolate) {
+  base::Optional<std::string> profile;
+  if (js_profiler_)
+    profile = js_profiler_->StopHeapProfiling();
+  if (!profile)
+    return v8::Null(isolate);
+  return gin::StringToV8(isolate, *profile);
+}
+
+v8::Local<v8::Value> App::GetSpareRendererPoolStats(v8::Isolate* isolate) {
+  SpareWebContentsPool::Stats stats =
+      SpareWebContentsPool::GetInstance()->GetStats();
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("hits", static_cast<double>(stats.hits));
+  dict.Set("misses", static_cast<double>(stats.misses));
+  dict.Set("count", static_cast<double>(stats.count));
+  return dict.GetHandle();
+}
+
 static void RemoveNoSandboxSwitch(base::CommandLine* command_line) {
   if (command_line->HasSwitch(sandbox::policy::switches::kNoSandbox)) {
     const base::CommandLine::CharType* noSandboxArg =
@@ -1653,6 +1868,15 @@ gin::ObjectTemplateBuilder App::GetObjectTemplateBuilder(v8::Isolate* isolate) {
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
+      .SetMethod("setSpareRendererPoolSize", &App::SetSpareRendererPoolSize)
+      .SetMethod("getSpareRendererPoolStats", &App::GetSpareRendererPoolStats)
+      .SetMethod("startMetricsSampler", &App::StartMetricsSampler)
+      .SetMethod("stopMetricsSampler", &App::StopMetricsSampler)
+      .SetMethod("getMetricsHistory", &App::GetMetricsHistory)
+      .SetMethod("startCpuProfiling", &App::StartCpuProfiling)
+      .SetMethod("stopCpuProfiling", &App::StopCpuProfiling)
+      .SetMethod("startHeapProfiling", &App::StartHeapProfiling)
+      .SetMethod("stopHeapProfiling", &App::StopHeapProfiling)
 #if defined(MAS_BUILD)
       .SetMethod("startAccessingSecurityScopedResource",
                  &App::StartAccessingSecurityScopedResource)
@@ -11,6 +11,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "base/task/cancelable_task_tracker.h"
 #include "chrome/browser/icon_manager.h"
 #include "chrome/browser/process_singleton.h"
@@ -40,6 +41,9 @@ class FilePath;
 
 namespace electron {
 
+class JsProfiler;
+class ProcessMetricsSampler;
+
 #if defined(OS_WIN)
 enum class JumpListResult : int;
 #endif
@@ -208,6 +212,20 @@ class App : public ElectronBrowserClient::Delegate,
   v8::Local<v8::Value> GetGPUFeatureStatus(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetGPUInfo(v8::Isolate* isolate,
                                     const std::string& info_type);
+  void SetSpareRendererPoolSize(gin_helper::ErrorThrower thrower,
+                                int size,
+                                gin::Arguments* args);
+  v8::Local<v8::Value> GetSpareRendererPoolStats(v8::Isolate* isolate);
+  void StartMetricsSampler(gin_helper::ErrorThrower thrower,
+                           gin::Arguments* args);
+  void StopMetricsSampler();
+  v8::Local<v8::Value> GetMetricsHistory(v8::Isolate* isolate);
+  void StartCpuProfiling(gin_helper::ErrorThrower thrower,
+                         gin::Arguments* args);
+  v8::Local<v8::Value> StopCpuProfiling(v8::Isolate* isolate);
+  void StartHeapProfiling(gin_helper::ErrorThrower thrower,
+                          gin::Arguments* args);
+  v8::Local<v8::Value> StopHeapProfiling(v8::Isolate* isolate);
   void EnableSandbox(gin_helper::ErrorThrower thrower);
   void SetUserAgentFallback(const std::string& user_agent);
   std::string GetUserAgentFallback();
@@ -252,9 +270,26 @@ class App : public ElectronBrowserClient::Delegate,
                          std::unique_ptr<electron::ProcessMetric>>;
   ProcessMetricMap app_metrics_;
 
+  std::unique_ptr<ProcessMetricsSampler> metrics_sampler_;
+
+  // Created on first use.
+  std::unique_ptr<JsProfiler> js_profiler_;
+
+#if defined(OS_LINUX)
+  // Samples the memory of all processes in |app_metrics_| on a background
+  // sequence, unless a previous sample is still in progress.
+  void RefreshMemoryInfo();
+  void OnMemoryInfoRefreshed(
+      std::vector<std::pair<base::ProcessId, ProcessMemoryInfo>> memory_info);
+
+  bool memory_refresh_pending_ = false;
+#endif
+
   bool disable_hw_acceleration_ = false;
   bool disable_domain_blocking_for_3DAPIs_ = false;
 
+  base::WeakPtrFactory<App> weak_factory_{this};
+
   DISALLOW_COPY_AND_ASSIGN(App);
 };
 
@@ -1252,6 +1252,23 @@ namespace {
 
 using electron::api::BaseWindow;
 
+// Returns [window, cursor] for the first window at or after |cursor|, or
+// undefined when there are no more windows.
+v8::Local<v8::Value> GetNextWindow(v8::Isolate* isolate, uint32_t cursor) {
+  size_t next = cursor;
+  v8::Local<v8::Object> window;
+  if (!BaseWindow::GetNext(isolate, &next).ToLocal(&window))
+    return v8::Undefined(isolate);
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Array> result = v8::Array::New(isolate, 2);
+  result->Set(context, 0, window).Check();
+  result
+      ->Set(context, 1,
+            v8::Integer::NewFromUnsigned(isolate, static_cast<uint32_t>(next)))
+      .Check();
+  return result;
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -1265,6 +1282,7 @@ void Initialize(v8::Local<v8::Object> exports,
                                          .ToLocalChecked());
   constructor.SetMethod("fromId", &BaseWindow::FromWeakMapID);
   constructor.SetMethod("getAllWindows", &BaseWindow::GetAll);
+  constructor.SetMethod("_getNextWindow", &GetNextWindow);
 
   gin_helper::Dictionary dict(isolate, exports);
   dict.Set("BaseWindow", constructor);
@@ -13,6 +13,7 @@
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_view_host.h"
 #include "shell/browser/api/electron_api_web_contents_view.h"
+#include "shell/browser/api/spare_web_contents_pool.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/unresponsive_suppressor.h"
 #include "shell/browser/web_contents_preferences.h"
@@ -58,10 +59,19 @@ BrowserWindow::BrowserWindow(gin::Arguments* args,
     web_preferences.Set(options::kShow, show);
   }
 
+  // Adopt a spare webContents created with the same webPreferences. The
+  // window options copied above are part of the match, since an adopted
+  // webContents has already been created without them.
+  gin::Handle<WebContents> spare;
+  if (!options.Get("webContents", &value))
+    spare = SpareWebContentsPool::GetInstance()->Take(isolate, web_preferences);
+
   // Copy the webContents option to webPreferences. This is only used internally
   // to implement nativeWindowOpen option.
   if (options.Get("webContents", &value)) {
     web_preferences.SetHidden("webContents", value);
+  } else if (!spare.IsEmpty()) {
+    web_preferences.SetHidden("webContents", spare.ToV8());
   }
 
   // Creates the WebContentsView.
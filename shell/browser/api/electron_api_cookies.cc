@@ -5,8 +5,14 @@
 #include "shell/browser/api/electron_api_cookies.h"
 
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "base/memory/ref_counted.h"
+#include "base/optional.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/browser_context.h"
@@ -98,63 +104,71 @@ namespace electron {
 
 namespace api {
 
-namespace {
+// The parsed form of the filters passed to cookies.get() and
+// cookies.setChangeNotificationOptions(), so that matching a large cookie jar
+// or a burst of changes doesn't look properties up for every cookie.
+struct CookieFilter {
+  base::Optional<std::string> name;
+  base::Optional<std::string> path;
+  // Stored without a leading '.' character.
+  base::Optional<std::string> domain;
+  base::Optional<bool> secure;
+  base::Optional<bool> session;
+  size_t offset = 0;
+  base::Optional<size_t> limit;
+};
 
-// Returns whether |domain| matches |filter|.
-bool MatchesDomain(std::string filter, const std::string& domain) {
-  // Add a leading '.' character to the filter domain if it doesn't exist.
-  if (net::cookie_util::DomainIsHostOnly(filter))
-    filter.insert(0, ".");
+namespace {
 
-  std::string sub_domain(domain);
+// Returns whether |domain| matches or is a subdomain of |filter|.
+bool MatchesDomain(base::StringPiece filter, base::StringPiece domain) {
   // Strip any leading '.' character from the input cookie domain.
-  if (!net::cookie_util::DomainIsHostOnly(sub_domain))
-    sub_domain = sub_domain.substr(1);
-
-  // Now check whether the domain argument is a subdomain of the filter domain.
-  for (sub_domain.insert(0, "."); sub_domain.length() >= filter.length();) {
-    if (sub_domain == filter)
-      return true;
-    const size_t next_dot = sub_domain.find('.', 1);  // Skip over leading dot.
-    sub_domain.erase(0, next_dot);
-  }
-  return false;
+  if (!domain.empty() && domain[0] == '.')
+    domain.remove_prefix(1);
+  if (!base::EndsWith(domain, filter, base::CompareCase::SENSITIVE))
+    return false;
+  return domain.size() == filter.size() ||
+         domain[domain.size() - filter.size() - 1] == '.';
 }
 
 // Returns whether |cookie| matches |filter|.
-bool MatchesCookie(const base::Value& filter,
+bool MatchesCookie(const CookieFilter& filter,
                    const net::CanonicalCookie& cookie) {
-  const std::string* str;
-  if ((str = filter.FindStringKey("name")) && *str != cookie.Name())
+  if (filter.name && *filter.name != cookie.Name())
     return false;
-  if ((str = filter.FindStringKey("path")) && *str != cookie.Path())
+  if (filter.path && *filter.path != cookie.Path())
     return false;
-  if ((str = filter.FindStringKey("domain")) &&
-      !MatchesDomain(*str, cookie.Domain()))
+  if (filter.domain && !MatchesDomain(*filter.domain, cookie.Domain()))
     return false;
-  base::Optional<bool> secure_filter = filter.FindBoolKey("secure");
-  if (secure_filter && *secure_filter == cookie.IsSecure())
+  if (filter.secure && *filter.secure != cookie.IsSecure())
     return false;
-  base::Optional<bool> session_filter = filter.FindBoolKey("session");
-  if (session_filter && *session_filter != !cookie.IsPersistent())
+  if (filter.session && *filter.session != !cookie.IsPersistent())
     return false;
   return true;
 }
 
 // Remove cookies from |list| not matching |filter|, and pass it to |callback|.
-void FilterCookies(const base::Value& filter,
+void FilterCookies(const CookieFilter& filter,
                    gin_helper::Promise<net::CookieList> promise,
                    const net::CookieList& cookies) {
   net::CookieList result;
+  size_t skipped = 0;
   for (const auto& cookie : cookies) {
-    if (MatchesCookie(filter, cookie))
-      result.push_back(cookie);
+    if (filter.limit && result.size() >= *filter.limit)
+      break;
+    if (!MatchesCookie(filter, cookie))
+      continue;
+    if (skipped < filter.offset) {
+      ++skipped;
+      continue;
+    }
+    result.push_back(cookie);
   }
   promise.Resolve(result);
 }
 
 void FilterCookieWithStatuses(
-    const base::Value& filter,
+    const CookieFilter& filter,
     gin_helper::Promise<net::CookieList> promise,
     const net::CookieAccessResultList& list,
     const net::CookieAccessResultList& excluded_list) {
@@ -214,6 +228,114 @@ std::string StringToCookieSameSite(const std::string* str_ptr,
   return "";
 }
 
+// Creates the cookie described by |details|, as passed to cookies.set().
+// Returns nullptr and sets |error| if |details| is invalid.
+std::unique_ptr<net::CanonicalCookie> CreateCookieFromDetails(
+    const base::Value& details,
+    GURL* url,
+    net::CookieOptions* options,
+    std::string* error) {
+  const std::string* url_string = details.FindStringKey("url");
+  const std::string* name = details.FindStringKey("name");
+  const std::string* value = details.FindStringKey("value");
+  const std::string* domain = details.FindStringKey("domain");
+  const std::string* path = details.FindStringKey("path");
+  bool secure = details.FindBoolKey("secure").value_or(false);
+  bool http_only = details.FindBoolKey("httpOnly").value_or(false);
+  const std::string* same_site_string = details.FindStringKey("sameSite");
+  net::CookieSameSite same_site;
+  *error = StringToCookieSameSite(same_site_string, &same_site);
+  if (!error->empty())
+    return nullptr;
+
+  *url = GURL(url_string ? *url_string : "");
+  if (!url->is_valid()) {
+    *error = InclusionStatusToString(net::CookieInclusionStatus(
+        net::CookieInclusionStatus::EXCLUDE_INVALID_DOMAIN));
+    return nullptr;
+  }
+
+  auto canonical_cookie = net::CanonicalCookie::CreateSanitizedCookie(
+      *url, name ? *name : "", value ? *value : "", domain ? *domain : "",
+      path ? *path : "",
+      ParseTimeProperty(details.FindDoubleKey("creationDate")),
+      ParseTimeProperty(details.FindDoubleKey("expirationDate")),
+      ParseTimeProperty(details.FindDoubleKey("lastAccessDate")), secure,
+      http_only, same_site, net::COOKIE_PRIORITY_DEFAULT);
+  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
+    *error = InclusionStatusToString(net::CookieInclusionStatus(
+        net::CookieInclusionStatus::EXCLUDE_FAILURE_TO_STORE));
+    return nullptr;
+  }
+  if (http_only) {
+    options->set_include_httponly();
+  }
+  options->set_same_site_cookie_context(
+      net::CookieOptions::SameSiteCookieContext::MakeInclusive());
+  return canonical_cookie;
+}
+
+// Cookie objects as returned by cookies.get() carry no url, so derive one
+// from the cookie's own domain, path and secure flag. This lets a jar saved
+// with cookies.get() be imported again with cookies.setMany().
+base::Value CookieToDetails(const base::Value& cookie) {
+  base::Value details = cookie.Clone();
+  const std::string* domain = cookie.FindStringKey("domain");
+  if (!domain)
+    return details;
+  const std::string* path = cookie.FindStringKey("path");
+  bool secure = cookie.FindBoolKey("secure").value_or(false);
+  std::string host = *domain;
+  if (!net::cookie_util::DomainIsHostOnly(host))
+    host.erase(0, 1);
+  details.SetStringKey("url", std::string(secure ? "https://" : "http://") +
+                                  host + (path ? *path : "/"));
+  if (cookie.FindBoolKey("hostOnly").value_or(false))
+    details.RemoveKey("domain");
+  return details;
+}
+
+// Collects the per-item results of cookies.setMany() and
+// cookies.removeMany(), and resolves the promise once every item is done.
+class CookieBatch : public base::RefCounted<CookieBatch> {
+ public:
+  CookieBatch(gin_helper::Promise<base::Value> promise, size_t size)
+      : promise_(std::move(promise)), errors_(size), pending_(size) {
+    if (pending_ == 0)
+      Resolve();
+  }
+
+  // An empty |error| means the item succeeded.
+  void SetResult(size_t index, const std::string& error) {
+    DCHECK_GT(pending_, 0u);
+    errors_[index] = error;
+    if (--pending_ == 0)
+      Resolve();
+  }
+
+ private:
+  friend class base::RefCounted<CookieBatch>;
+  ~CookieBatch() = default;
+
+  void Resolve() {
+    base::Value results(base::Value::Type::LIST);
+    for (const auto& error : errors_) {
+      base::Value result(base::Value::Type::DICTIONARY);
+      result.SetBoolKey("success", error.empty());
+      if (!error.empty())
+        result.SetStringKey("error", error);
+      results.Append(std::move(result));
+    }
+    promise_.Resolve(results);
+  }
+
+  gin_helper::Promise<base::Value> promise_;
+  std::vector<std::string> errors_;
+  size_t pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(CookieBatch);
+};
+
 }  // namespace
 
 gin::WrapperInfo Cookies::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -233,18 +355,49 @@ v8::Local<v8::Promise> Cookies::Get(v8::Isolate* isolate,
   gin_helper::Promise<net::CookieList> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
+  CookieFilter cookie_filter;
+  std::string str;
+  if (filter.Get("name", &str))
+    cookie_filter.name = str;
+  if (filter.Get("path", &str))
+    cookie_filter.path = str;
+  if (filter.Get("domain", &str)) {
+    // Strip any leading '.' character from the filter domain.
+    if (!net::cookie_util::DomainIsHostOnly(str))
+      str.erase(0, 1);
+    cookie_filter.domain = str;
+  }
+  bool flag;
+  if (filter.Get("secure", &flag))
+    cookie_filter.secure = flag;
+  if (filter.Get("session", &flag))
+    cookie_filter.session = flag;
+  int offset = 0;
+  if (filter.Get("offset", &offset)) {
+    if (offset < 0) {
+      promise.RejectWithErrorMessage("offset must not be negative");
+      return handle;
+    }
+    cookie_filter.offset = offset;
+  }
+  int limit;
+  if (filter.Get("limit", &limit)) {
+    if (limit < 0) {
+      promise.RejectWithErrorMessage("limit must not be negative");
+      return handle;
+    }
+    cookie_filter.limit = limit;
+  }
+
   auto* storage_partition =
       content::BrowserContext::GetDefaultStoragePartition(browser_context_);
   auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
 
-  base::DictionaryValue dict;
-  gin::ConvertFromV8(isolate, filter.GetHandle(), &dict);
-
   std::string url;
   filter.Get("url", &url);
   if (url.empty()) {
-    manager->GetAllCookies(
-        base::BindOnce(&FilterCookies, std::move(dict), std::move(promise)));
+    manager->GetAllCookies(base::BindOnce(
+        &FilterCookies, std::move(cookie_filter), std::move(promise)));
   } else {
     net::CookieOptions options;
     options.set_include_httponly();
@@ -252,9 +405,10 @@ v8::Local<v8::Promise> Cookies::Get(v8::Isolate* isolate,
         net::CookieOptions::SameSiteCookieContext::MakeInclusive());
     options.set_do_not_update_access_time();
 
-    manager->GetCookieList(GURL(url), options,
-                           base::BindOnce(&FilterCookieWithStatuses,
-                                          std::move(dict), std::move(promise)));
+    manager->GetCookieList(
+        GURL(url), options,
+        base::BindOnce(&FilterCookieWithStatuses, std::move(cookie_filter),
+                       std::move(promise)));
   }
 
   return handle;
@@ -290,49 +444,16 @@ v8::Local<v8::Promise> Cookies::Set(v8::Isolate* isolate,
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  const std::string* url_string = details.FindStringKey("url");
-  const std::string* name = details.FindStringKey("name");
-  const std::string* value = details.FindStringKey("value");
-  const std::string* domain = details.FindStringKey("domain");
-  const std::string* path = details.FindStringKey("path");
-  bool secure = details.FindBoolKey("secure").value_or(false);
-  bool http_only = details.FindBoolKey("httpOnly").value_or(false);
-  const std::string* same_site_string = details.FindStringKey("sameSite");
-  net::CookieSameSite same_site;
-  std::string error = StringToCookieSameSite(same_site_string, &same_site);
-  if (!error.empty()) {
+  GURL url;
+  net::CookieOptions options;
+  std::string error;
+  auto canonical_cookie =
+      CreateCookieFromDetails(details, &url, &options, &error);
+  if (!canonical_cookie) {
     promise.RejectWithErrorMessage(error);
     return handle;
   }
 
-  GURL url(url_string ? *url_string : "");
-  if (!url.is_valid()) {
-    promise.RejectWithErrorMessage(
-        InclusionStatusToString(net::CookieInclusionStatus(
-            net::CookieInclusionStatus::EXCLUDE_INVALID_DOMAIN)));
-    return handle;
-  }
-
-  auto canonical_cookie = net::CanonicalCookie::CreateSanitizedCookie(
-      url, name ? *name : "", value ? *value : "", domain ? *domain : "",
-      path ? *path : "",
-      ParseTimeProperty(details.FindDoubleKey("creationDate")),
-      ParseTimeProperty(details.FindDoubleKey("expirationDate")),
-      ParseTimeProperty(details.FindDoubleKey("lastAccessDate")), secure,
-      http_only, same_site, net::COOKIE_PRIORITY_DEFAULT);
-  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
-    promise.RejectWithErrorMessage(
-        InclusionStatusToString(net::CookieInclusionStatus(
-            net::CookieInclusionStatus::EXCLUDE_FAILURE_TO_STORE)));
-    return handle;
-  }
-  net::CookieOptions options;
-  if (http_only) {
-    options.set_include_httponly();
-  }
-  options.set_same_site_cookie_context(
-      net::CookieOptions::SameSiteCookieContext::MakeInclusive());
-
   auto* storage_partition =
       content::BrowserContext::GetDefaultStoragePartition(browser_context_);
   auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
@@ -351,6 +472,91 @@ v8::Local<v8::Promise> Cookies::Set(v8::Isolate* isolate,
   return handle;
 }
 
+v8::Local<v8::Promise> Cookies::SetMany(v8::Isolate* isolate,
+                                        const base::ListValue& cookies) {
+  gin_helper::Promise<base::Value> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* storage_partition =
+      content::BrowserContext::GetDefaultStoragePartition(browser_context_);
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+
+  // All requests are queued on the cookie manager pipe up front rather than
+  // waiting for each reply in turn.
+  auto batch = base::MakeRefCounted<CookieBatch>(std::move(promise),
+                                                 cookies.GetList().size());
+  for (size_t i = 0; i < cookies.GetList().size(); ++i) {
+    const base::Value& item = cookies.GetList()[i];
+    if (!item.is_dict()) {
+      batch->SetResult(i, "Expected an object");
+      continue;
+    }
+    GURL url;
+    net::CookieOptions options;
+    std::string error;
+    std::unique_ptr<net::CanonicalCookie> canonical_cookie;
+    if (item.FindKey("url")) {
+      canonical_cookie = CreateCookieFromDetails(item, &url, &options, &error);
+    } else {
+      canonical_cookie = CreateCookieFromDetails(CookieToDetails(item), &url,
+                                                 &options, &error);
+    }
+    if (!canonical_cookie) {
+      batch->SetResult(i, error);
+      continue;
+    }
+    manager->SetCanonicalCookie(
+        *canonical_cookie, url, options,
+        base::BindOnce(
+            [](scoped_refptr<CookieBatch> batch, size_t index,
+               net::CookieAccessResult r) {
+              batch->SetResult(index, r.status.IsInclude()
+                                          ? std::string()
+                                          : InclusionStatusToString(r.status));
+            },
+            batch, i));
+  }
+
+  return handle;
+}
+
+v8::Local<v8::Promise> Cookies::RemoveMany(v8::Isolate* isolate,
+                                           const base::ListValue& cookies) {
+  gin_helper::Promise<base::Value> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* storage_partition =
+      content::BrowserContext::GetDefaultStoragePartition(browser_context_);
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+
+  auto batch = base::MakeRefCounted<CookieBatch>(std::move(promise),
+                                                 cookies.GetList().size());
+  for (size_t i = 0; i < cookies.GetList().size(); ++i) {
+    const base::Value& item = cookies.GetList()[i];
+    const std::string* url = item.is_dict() ? item.FindStringKey("url")
+                                            : nullptr;
+    const std::string* name = item.is_dict() ? item.FindStringKey("name")
+                                             : nullptr;
+    if (!url || !name || !GURL(*url).is_valid()) {
+      batch->SetResult(i, "Expected an object with a valid url and a name");
+      continue;
+    }
+    auto cookie_deletion_filter = network::mojom::CookieDeletionFilter::New();
+    cookie_deletion_filter->url = GURL(*url);
+    cookie_deletion_filter->cookie_name = *name;
+    manager->DeleteCookies(
+        std::move(cookie_deletion_filter),
+        base::BindOnce(
+            [](scoped_refptr<CookieBatch> batch, size_t index,
+               uint32_t num_deleted) {
+              batch->SetResult(index, std::string());
+            },
+            batch, i));
+  }
+
+  return handle;
+}
+
 v8::Local<v8::Promise> Cookies::FlushStore(v8::Isolate* isolate) {
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
@@ -365,7 +571,48 @@ v8::Local<v8::Promise> Cookies::FlushStore(v8::Isolate* isolate) {
   return handle;
 }
 
+v8::Local<v8::Value> Cookies::SetChangeNotificationOptions(
+    gin_helper::ErrorThrower thrower,
+    const gin_helper::Dictionary& options) {
+  int batch_interval = -1;
+  if (options.Get("batchInterval", &batch_interval) && batch_interval < 0) {
+    thrower.ThrowTypeError("batchInterval must not be negative");
+    return v8::Undefined(thrower.isolate());
+  }
+
+  // Deliver what was queued under the previous options first.
+  FlushCookieChanges();
+
+  change_batch_interval_ = batch_interval;
+  change_filter_ = std::make_unique<CookieFilter>();
+  std::string str;
+  if (options.Get("name", &str))
+    change_filter_->name = str;
+  if (options.Get("domain", &str)) {
+    // Strip any leading '.' character from the filter domain.
+    if (!net::cookie_util::DomainIsHostOnly(str))
+      str.erase(0, 1);
+    change_filter_->domain = str;
+  }
+  return v8::Undefined(thrower.isolate());
+}
+
 void Cookies::OnCookieChanged(const net::CookieChangeInfo& change) {
+  if (change_filter_ && !MatchesCookie(*change_filter_, change.cookie))
+    return;
+
+  if (change_batch_interval_ >= 0) {
+    pending_changes_.push_back(change);
+    if (!change_batch_timer_.IsRunning()) {
+      change_batch_timer_.Start(
+          FROM_HERE,
+          base::TimeDelta::FromMilliseconds(change_batch_interval_),
+          base::BindOnce(&Cookies::FlushCookieChanges,
+                         base::Unretained(this)));
+    }
+    return;
+  }
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   Emit("changed", gin::ConvertToV8(isolate, change.cookie),
@@ -374,6 +621,27 @@ void Cookies::OnCookieChanged(const net::CookieChangeInfo& change) {
                         change.cause != net::CookieChangeCause::INSERTED));
 }
 
+void Cookies::FlushCookieChanges() {
+  change_batch_timer_.Stop();
+  if (pending_changes_.empty())
+    return;
+  std::vector<net::CookieChangeInfo> changes;
+  changes.swap(pending_changes_);
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Array> array = v8::Array::New(isolate, changes.size());
+  for (size_t i = 0; i < changes.size(); ++i) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("cookie", changes[i].cookie);
+    dict.Set("cause", changes[i].cause);
+    dict.Set("removed", changes[i].cause != net::CookieChangeCause::INSERTED);
+    array->Set(context, i, dict.GetHandle()).Check();
+  }
+  Emit("changed-batch", array);
+}
+
 // static
 gin::Handle<Cookies> Cookies::Create(v8::Isolate* isolate,
                                      ElectronBrowserContext* browser_context) {
@@ -387,7 +655,11 @@ gin::ObjectTemplateBuilder Cookies::GetObjectTemplateBuilder(
       .SetMethod("get", &Cookies::Get)
       .SetMethod("remove", &Cookies::Remove)
       .SetMethod("set", &Cookies::Set)
-      .SetMethod("flushStore", &Cookies::FlushStore);
+      .SetMethod("setMany", &Cookies::SetMany)
+      .SetMethod("removeMany", &Cookies::RemoveMany)
+      .SetMethod("flushStore", &Cookies::FlushStore)
+      .SetMethod("setChangeNotificationOptions",
+                 &Cookies::SetChangeNotificationOptions);
 }
 
 const char* Cookies::GetTypeName() {
@@ -7,17 +7,21 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback_list.h"
+#include "base/timer/timer.h"
 #include "gin/handle.h"
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_change_dispatcher.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/gin_helper/trackable_object.h"
 
 namespace base {
 class DictionaryValue;
+class ListValue;
 }
 
 namespace gin_helper {
@@ -34,6 +38,8 @@ class ElectronBrowserContext;
 
 namespace api {
 
+struct CookieFilter;
+
 class Cookies : public gin::Wrappable<Cookies>,
                 public gin_helper::EventEmitterMixin<Cookies> {
  public:
@@ -57,11 +63,20 @@ class Cookies : public gin::Wrappable<Cookies>,
   v8::Local<v8::Promise> Remove(v8::Isolate*,
                                 const GURL& url,
                                 const std::string& name);
+  v8::Local<v8::Promise> SetMany(v8::Isolate*, const base::ListValue& cookies);
+  v8::Local<v8::Promise> RemoveMany(v8::Isolate*,
+                                    const base::ListValue& cookies);
   v8::Local<v8::Promise> FlushStore(v8::Isolate*);
+  v8::Local<v8::Value> SetChangeNotificationOptions(
+      gin_helper::ErrorThrower thrower,
+      const gin_helper::Dictionary& options);
 
   // CookieChangeNotifier subscription:
   void OnCookieChanged(const net::CookieChangeInfo& change);
 
+  // Emits the changes queued in batched mode as one event.
+  void FlushCookieChanges();
+
  private:
   std::unique_ptr<base::CallbackList<void(
       const net::CookieChangeInfo& change)>::Subscription>
@@ -70,6 +85,14 @@ class Cookies : public gin::Wrappable<Cookies>,
   // Weak reference; ElectronBrowserContext is guaranteed to outlive us.
   ElectronBrowserContext* browser_context_;
 
+  // Changes not matching |change_filter_| are dropped before reaching JS.
+  std::unique_ptr<CookieFilter> change_filter_;
+  // Milliseconds to collect changes for a 'changed-batch' event, or -1 to
+  // emit a 'changed' event for each change.
+  int change_batch_interval_ = -1;
+  std::vector<net::CookieChangeInfo> pending_changes_;
+  base::OneShotTimer change_batch_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(Cookies);
 };
 
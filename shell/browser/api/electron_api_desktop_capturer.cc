@@ -72,8 +72,12 @@ DesktopCapturer::~DesktopCapturer() = default;
 void DesktopCapturer::StartHandling(bool capture_window,
                                     bool capture_screen,
                                     const gfx::Size& thumbnail_size,
-                                    bool fetch_window_icons) {
+                                    bool fetch_window_icons,
+                                    bool stream_sources) {
   fetch_window_icons_ = fetch_window_icons;
+  stream_sources_ = stream_sources;
+  thumbnails_enabled_ = !thumbnail_size.IsEmpty();
+  streamed_sources_.clear();
 #if defined(OS_WIN)
   if (content::desktop_capture::CreateDesktopCaptureOptions()
           .allow_directx_capturer()) {
@@ -118,10 +122,44 @@ void DesktopCapturer::StartHandling(bool capture_window,
   }
 }
 
+void DesktopCapturer::OnSourceAdded(DesktopMediaList* list, int index) {
+  // Without thumbnails there is nothing left to wait for once a window has
+  // been enumerated.
+  if (ShouldStreamFrom(list) && !thumbnails_enabled_) {
+    StreamSource(DesktopCapturer::Source{list->GetSource(index), std::string(),
+                                         fetch_window_icons_});
+  }
+}
+
+void DesktopCapturer::OnSourceThumbnailChanged(DesktopMediaList* list,
+                                               int index) {
+  if (ShouldStreamFrom(list)) {
+    StreamSource(DesktopCapturer::Source{list->GetSource(index), std::string(),
+                                         fetch_window_icons_});
+  }
+}
+
 void DesktopCapturer::OnSourceUnchanged(DesktopMediaList* list) {
   UpdateSourcesList(list);
 }
 
+bool DesktopCapturer::ShouldStreamFrom(DesktopMediaList* list) const {
+  // Screen sources are streamed once the whole list is known, since their
+  // display ids can only be resolved together.
+  return stream_sources_ && capture_window_ &&
+         list->GetMediaListType() == content::DesktopMediaID::TYPE_WINDOW;
+}
+
+void DesktopCapturer::StreamSource(const DesktopCapturer::Source& source) {
+  if (!streamed_sources_.insert(source.media_list_source.id).second)
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::Locker locker(isolate);
+  v8::HandleScope scope(isolate);
+  gin_helper::CallMethod(this, "_onsource", source);
+}
+
 void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
   if (capture_window_ &&
       list->GetMediaListType() == content::DesktopMediaID::TYPE_WINDOW) {
@@ -133,6 +171,11 @@ void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
       window_sources.emplace_back(DesktopCapturer::Source{
           media_list_source, std::string(), fetch_window_icons_});
     }
+    if (stream_sources_) {
+      // Sources whose thumbnail did not need to be delivered separately.
+      for (const auto& source : window_sources)
+        StreamSource(source);
+    }
     std::move(window_sources.begin(), window_sources.end(),
               std::back_inserter(captured_sources_));
   }
@@ -186,6 +229,10 @@ void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
     // TODO(ajmacd): Add Linux support. The IDs across APIs differ but Chrome
     // only supports capturing the entire desktop on Linux. Revisit this if
     // individual screen support is added.
+    if (stream_sources_) {
+      for (const auto& source : screen_sources)
+        StreamSource(source);
+    }
     std::move(screen_sources.begin(), screen_sources.end(),
               std::back_inserter(captured_sources_));
   }
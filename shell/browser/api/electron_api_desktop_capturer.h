@@ -6,6 +6,7 @@
 #define SHELL_BROWSER_API_ELECTRON_API_DESKTOP_CAPTURER_H_
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -32,10 +33,14 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
 
   static gin::Handle<DesktopCapturer> Create(v8::Isolate* isolate);
 
+  // When |stream_sources| is set, each source is also emitted through
+  // "_onsource" as soon as its thumbnail is available, instead of only being
+  // part of the final list once every thumbnail has been captured.
   void StartHandling(bool capture_window,
                      bool capture_screen,
                      const gfx::Size& thumbnail_size,
-                     bool fetch_window_icons);
+                     bool fetch_window_icons,
+                     bool stream_sources);
 
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
@@ -48,17 +53,21 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
   ~DesktopCapturer() override;
 
   // DesktopMediaListObserver:
-  void OnSourceAdded(DesktopMediaList* list, int index) override {}
+  void OnSourceAdded(DesktopMediaList* list, int index) override;
   void OnSourceRemoved(DesktopMediaList* list, int index) override {}
   void OnSourceMoved(DesktopMediaList* list,
                      int old_index,
                      int new_index) override {}
   void OnSourceNameChanged(DesktopMediaList* list, int index) override {}
-  void OnSourceThumbnailChanged(DesktopMediaList* list, int index) override {}
+  void OnSourceThumbnailChanged(DesktopMediaList* list, int index) override;
   void OnSourceUnchanged(DesktopMediaList* list) override;
 
  private:
   void UpdateSourcesList(DesktopMediaList* list);
+  // Emits |source| through "_onsource" unless it was already streamed.
+  void StreamSource(const DesktopCapturer::Source& source);
+
+  bool ShouldStreamFrom(DesktopMediaList* list) const;
 
   std::unique_ptr<DesktopMediaList> window_capturer_;
   std::unique_ptr<DesktopMediaList> screen_capturer_;
@@ -66,6 +75,9 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
   bool capture_window_ = false;
   bool capture_screen_ = false;
   bool fetch_window_icons_ = false;
+  bool stream_sources_ = false;
+  bool thumbnails_enabled_ = true;
+  std::set<content::DesktopMediaID> streamed_sources_;
 #if defined(OS_WIN)
   bool using_directx_capturer_ = false;
 #endif  // defined(OS_WIN)
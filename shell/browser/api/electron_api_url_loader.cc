@@ -13,6 +13,10 @@
 
 #include "base/containers/id_map.h"
 #include "base/no_destructor.h"
+#include "base/sequence_checker.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
@@ -20,13 +24,16 @@
 #include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "net/base/load_flags.h"
 #include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
 #include "services/network/public/mojom/chunked_data_pipe_getter.mojom.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -239,6 +246,12 @@ const net::NetworkTrafficAnnotationTag kTrafficAnnotation =
           setting: "This feature cannot be disabled."
         })");
 
+// Don't let a loader read arbitrarily far ahead of a busy UI thread.
+constexpr size_t kMaxInFlightResponseBytes = 4 * 1024 * 1024;
+
+// Upper bound of the responseBufferSize option, keep in sync with net.ts.
+constexpr int kMaxResponseBufferSize = 16 * 1024 * 1024;
+
 base::IDMap<SimpleURLLoaderWrapper*>& GetAllRequests() {
   static base::NoDestructor<base::IDMap<SimpleURLLoaderWrapper*>>
       s_all_requests;
@@ -250,35 +263,255 @@ base::IDMap<SimpleURLLoaderWrapper*>& GetAllRequests() {
 gin::WrapperInfo SimpleURLLoaderWrapper::kWrapperInfo = {
     gin::kEmbedderNativeGin};
 
+// Owns the SimpleURLLoader on |core_task_runner_|. Response data is coalesced
+// there and only the resulting events are forwarded to the UI thread.
+class SimpleURLLoaderWrapper::Core
+    : public network::SimpleURLLoaderStreamConsumer {
+ public:
+  Core(base::WeakPtr<SimpleURLLoaderWrapper> wrapper,
+       bool run_on_ui_thread,
+       bool fail_on_redirect,
+       size_t response_buffer_size)
+      : wrapper_(wrapper),
+        ui_task_runner_(base::SequencedTaskRunnerHandle::Get()),
+        run_on_ui_thread_(run_on_ui_thread),
+        fail_on_redirect_(fail_on_redirect),
+        response_buffer_size_(response_buffer_size),
+        max_in_flight_bytes_(
+            std::max(kMaxInFlightResponseBytes, response_buffer_size)) {
+    DETACH_FROM_SEQUENCE(sequence_checker_);
+  }
+
+  ~Core() override { DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_); }
+
+  void Start(std::unique_ptr<network::ResourceRequest> request,
+             std::unique_ptr<network::PendingSharedURLLoaderFactory>
+                 pending_url_loader_factory,
+             const base::FilePath& save_path) {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    url_loader_factory_ = network::SharedURLLoaderFactory::Create(
+        std::move(pending_url_loader_factory));
+
+    // SimpleURLLoader wants to control the request body itself. We have other
+    // ideas.
+    auto request_body = std::move(request->request_body);
+    auto* request_ref = request.get();
+    loader_ = network::SimpleURLLoader::Create(std::move(request),
+                                               kTrafficAnnotation);
+    if (request_body) {
+      request_ref->request_body = std::move(request_body);
+    }
+
+    loader_->SetAllowHttpErrorResults(true);
+    loader_->SetOnResponseStartedCallback(
+        base::BindOnce(&Core::OnResponseStarted, base::Unretained(this)));
+    loader_->SetOnRedirectCallback(
+        base::BindRepeating(&Core::OnRedirect, base::Unretained(this)));
+    loader_->SetOnUploadProgressCallback(
+        base::BindRepeating(&Core::OnUploadProgress, base::Unretained(this)));
+    loader_->SetOnDownloadProgressCallback(
+        base::BindRepeating(&Core::OnDownloadProgress, base::Unretained(this)));
+
+    if (save_path.empty()) {
+      loader_->DownloadAsStream(url_loader_factory_.get(), this);
+    } else {
+      // The body is written by the loader on a background sequence without
+      // going through JS.
+      loader_->DownloadToFile(
+          url_loader_factory_.get(),
+          base::BindOnce(&Core::OnDownloadedToFile, base::Unretained(this)),
+          save_path);
+    }
+  }
+
+  // Stops the request. When the core runs on the UI thread this may happen
+  // inside one of the loader's callbacks, e.g. from a 'redirect' handler, in
+  // which case SimpleURLLoader notices its deletion and neither follows the
+  // redirect nor calls back again.
+  void CancelLoader() {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    loader_.reset();
+  }
+
+  // Called once JS has received |size| bytes of data sent by this core.
+  void OnDataConsumed(size_t size) {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    DCHECK_GE(in_flight_bytes_, size);
+    in_flight_bytes_ -= size;
+    if (resume_ && in_flight_bytes_ <= max_in_flight_bytes_)
+      std::move(resume_).Run();
+  }
+
+ private:
+  // network::SimpleURLLoaderStreamConsumer:
+  void OnDataReceived(base::StringPiece string_piece,
+                      base::OnceClosure resume) override {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    while (!string_piece.empty()) {
+      size_t size = string_piece.size();
+      if (response_buffer_size_ > 0)
+        size = std::min(size, response_buffer_size_ - pending_size_);
+      AppendPendingData(string_piece.substr(0, size));
+      string_piece.remove_prefix(size);
+      if (pending_size_ >= response_buffer_size_)
+        FlushPendingData();
+    }
+    if (in_flight_bytes_ > max_in_flight_bytes_)
+      resume_ = std::move(resume);
+    else
+      std::move(resume).Run();
+  }
+
+  void OnComplete(bool success) override {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    if (success)
+      FlushPendingData();
+    Notify(base::BindOnce(&SimpleURLLoaderWrapper::OnComplete, wrapper_,
+                          success, loader_->NetError()));
+  }
+
+  void OnRetry(base::OnceClosure start_retry) override {}
+
+  void OnDownloadedToFile(base::FilePath path) { OnComplete(!path.empty()); }
+
+  void OnResponseStarted(const GURL& final_url,
+                         const network::mojom::URLResponseHead& response_head) {
+    expected_bytes_ = response_head.content_length;
+    Notify(base::BindOnce(&SimpleURLLoaderWrapper::OnResponseStarted, wrapper_,
+                          final_url, response_head.Clone()));
+  }
+
+  void OnRedirect(const net::RedirectInfo& redirect_info,
+                  const network::mojom::URLResponseHead& response_head,
+                  std::vector<std::string>* removed_headers) {
+    auto head = response_head.Clone();
+    // When loading off the UI thread the redirect would be followed before JS
+    // gets to see it, so stop here and let JS fail the request.
+    if (fail_on_redirect_)
+      loader_.reset();
+    Notify(base::BindOnce(&SimpleURLLoaderWrapper::OnRedirect, wrapper_,
+                          redirect_info, std::move(head)));
+  }
+
+  void OnUploadProgress(uint64_t position, uint64_t total) {
+    Notify(base::BindOnce(&SimpleURLLoaderWrapper::OnUploadProgress, wrapper_,
+                          position, total));
+  }
+
+  void OnDownloadProgress(uint64_t current) {
+    Notify(base::BindOnce(&SimpleURLLoaderWrapper::OnDownloadProgress,
+                          wrapper_, current));
+  }
+
+  // Copies |data|, which is only valid during OnDataReceived(), into the
+  // pending chunks. A new chunk reserves room for as much of the rest of the
+  // buffer as Content-Length says is still coming, so that responses with a
+  // correct Content-Length fill a single chunk without reallocating it.
+  void AppendPendingData(base::StringPiece data) {
+    if (expected_bytes_ > 0)
+      expected_bytes_ -= std::min<int64_t>(expected_bytes_, data.size());
+    if (pending_chunks_.empty() ||
+        pending_chunks_.back()->capacity() - pending_chunks_.back()->size() <
+            data.size()) {
+      size_t capacity = data.size();
+      if (expected_bytes_ > 0 && response_buffer_size_ > 0) {
+        size_t room = response_buffer_size_ - pending_size_ - data.size();
+        capacity += std::min<size_t>(expected_bytes_, room);
+      }
+      auto chunk = std::make_unique<std::vector<char>>();
+      chunk->reserve(capacity);
+      pending_chunks_.push_back(std::move(chunk));
+    }
+    pending_chunks_.back()->insert(pending_chunks_.back()->end(), data.begin(),
+                                   data.end());
+    pending_size_ += data.size();
+  }
+
+  void FlushPendingData() {
+    if (pending_size_ == 0)
+      return;
+    std::unique_ptr<std::vector<char>> data;
+    if (pending_chunks_.size() == 1) {
+      data = std::move(pending_chunks_.front());
+    } else {
+      // Content-Length was missing or too small. Join the chunks into a
+      // buffer of the final size rather than growing one as they came in.
+      data = std::make_unique<std::vector<char>>();
+      data->reserve(pending_size_);
+      for (const auto& chunk : pending_chunks_)
+        data->insert(data->end(), chunk->begin(), chunk->end());
+    }
+    pending_chunks_.clear();
+    pending_size_ = 0;
+    in_flight_bytes_ += data->size();
+    Notify(base::BindOnce(&SimpleURLLoaderWrapper::OnData, wrapper_,
+                          std::move(data)));
+  }
+
+  void Notify(base::OnceClosure closure) {
+    if (run_on_ui_thread_)
+      std::move(closure).Run();
+    else
+      ui_task_runner_->PostTask(FROM_HERE, std::move(closure));
+  }
+
+  base::WeakPtr<SimpleURLLoaderWrapper> wrapper_;
+  scoped_refptr<base::SequencedTaskRunner> ui_task_runner_;
+  const bool run_on_ui_thread_;
+  const bool fail_on_redirect_;
+  const size_t response_buffer_size_;
+  const size_t max_in_flight_bytes_;
+
+  scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
+  std::unique_ptr<network::SimpleURLLoader> loader_;
+  // Response data not sent to the UI thread yet, |pending_size_| bytes in
+  // total.
+  std::vector<std::unique_ptr<std::vector<char>>> pending_chunks_;
+  size_t pending_size_ = 0;
+  // Bytes still to come according to Content-Length, or -1 when unknown.
+  int64_t expected_bytes_ = -1;
+  // Bytes sent to the UI thread that JS has not received yet.
+  size_t in_flight_bytes_ = 0;
+  base::OnceClosure resume_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  DISALLOW_COPY_AND_ASSIGN(Core);
+};
+
 SimpleURLLoaderWrapper::SimpleURLLoaderWrapper(
     std::unique_ptr<network::ResourceRequest> request,
-    network::mojom::URLLoaderFactory* url_loader_factory)
+    std::unique_ptr<network::PendingSharedURLLoaderFactory> url_loader_factory,
+    const std::string& redirect_policy,
+    bool load_on_ui_thread,
+    size_t response_buffer_size,
+    const base::FilePath& save_path)
     : id_(GetAllRequests().Add(this)) {
   // We slightly abuse the |render_frame_id| field in ResourceRequest so that
   // we can correlate any authentication events that arrive with this request.
   request->render_frame_id = id_;
 
-  // SimpleURLLoader wants to control the request body itself. We have other
-  // ideas.
-  auto request_body = std::move(request->request_body);
-  auto* request_ref = request.get();
-  loader_ =
-      network::SimpleURLLoader::Create(std::move(request), kTrafficAnnotation);
-  if (request_body) {
-    request_ref->request_body = std::move(request_body);
-  }
-
-  loader_->SetAllowHttpErrorResults(true);
-  loader_->SetOnResponseStartedCallback(base::BindOnce(
-      &SimpleURLLoaderWrapper::OnResponseStarted, base::Unretained(this)));
-  loader_->SetOnRedirectCallback(base::BindRepeating(
-      &SimpleURLLoaderWrapper::OnRedirect, base::Unretained(this)));
-  loader_->SetOnUploadProgressCallback(base::BindRepeating(
-      &SimpleURLLoaderWrapper::OnUploadProgress, base::Unretained(this)));
-  loader_->SetOnDownloadProgressCallback(base::BindRepeating(
-      &SimpleURLLoaderWrapper::OnDownloadProgress, base::Unretained(this)));
-
-  loader_->DownloadAsStream(url_loader_factory, this);
+  // A 'manual' redirect has to be decided by JS before the loader continues,
+  // which is only possible when the loader lives on the UI thread. The same
+  // goes for 'follow' requests whose 'redirect' handlers may abort them.
+  bool run_on_ui_thread = load_on_ui_thread || redirect_policy == "manual";
+  if (run_on_ui_thread) {
+    core_task_runner_ = base::SequencedTaskRunnerHandle::Get();
+  } else {
+    core_task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
+        {base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
+  }
+  core_ = std::make_unique<Core>(weak_factory_.GetWeakPtr(), run_on_ui_thread,
+                                 redirect_policy == "error",
+                                 response_buffer_size);
+  // Unretained is safe because |core_| is only ever deleted on
+  // |core_task_runner_|, after this task has run.
+  core_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&Core::Start, base::Unretained(core_.get()),
+                     std::move(request), std::move(url_loader_factory),
+                     save_path));
 }
 
 void SimpleURLLoaderWrapper::Pin() {
@@ -293,6 +526,7 @@ void SimpleURLLoaderWrapper::PinBodyGetter(v8::Local<v8::Value> body_getter) {
 }
 
 SimpleURLLoaderWrapper::~SimpleURLLoaderWrapper() {
+  DestroyCore();
   GetAllRequests().Remove(id_);
 }
 
@@ -333,11 +567,24 @@ void SimpleURLLoaderWrapper::OnAuthRequired(
 }
 
 void SimpleURLLoaderWrapper::Cancel() {
-  loader_.reset();
+  DestroyCore();
   pinned_wrapper_.Reset();
   pinned_chunk_pipe_getter_.Reset();
+}
+
+void SimpleURLLoaderWrapper::DestroyCore() {
+  if (!core_)
+    return;
   // This ensures that no further callbacks will be called, so there's no need
-  // for additional guards.
+  // for additional guards. The core itself may be in the middle of one of its
+  // callbacks, so it is always deleted asynchronously.
+  weak_factory_.InvalidateWeakPtrs();
+  // A loader on this thread has to stop synchronously though, or a 'manual'
+  // redirect cancelled by JS would still be followed before the core is
+  // deleted.
+  if (core_task_runner_->RunsTasksInCurrentSequence())
+    core_->CancelLoader();
+  core_task_runner_->DeleteSoon(FROM_HERE, std::move(core_));
 }
 
 // static
@@ -398,6 +645,21 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
     }
   }
 
+  int response_buffer_size = 0;
+  if (opts.Get("responseBufferSize", &response_buffer_size) &&
+      (response_buffer_size < 0 ||
+       response_buffer_size > kMaxResponseBufferSize)) {
+    args->ThrowTypeError("responseBufferSize must be between 0 and " +
+                         base::NumberToString(kMaxResponseBufferSize));
+    return gin::Handle<SimpleURLLoaderWrapper>();
+  }
+  base::FilePath save_path;
+  opts.Get("savePath", &save_path);
+  std::string redirect_policy = "follow";
+  opts.Get("redirectPolicy", &redirect_policy);
+  bool load_on_ui_thread = false;
+  opts.Get("loadOnUIThread", &load_on_ui_thread);
+
   std::string partition;
   gin::Handle<Session> session;
   if (!opts.Get("session", &session)) {
@@ -407,11 +669,16 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
       session = Session::FromPartition(args->isolate(), "");
   }
 
-  auto url_loader_factory = session->browser_context()->GetURLLoaderFactory();
+  auto url_loader_factory =
+      session->browser_context()->GetURLLoaderFactory()->Clone();
 
   auto ret = gin::CreateHandle(
       args->isolate(),
-      new SimpleURLLoaderWrapper(std::move(request), url_loader_factory.get()));
+      new SimpleURLLoaderWrapper(std::move(request),
+                                 std::move(url_loader_factory), redirect_policy,
+                                 load_on_ui_thread,
+                                 static_cast<size_t>(response_buffer_size),
+                                 save_path));
   ret->Pin();
   if (!chunk_pipe_getter.IsEmpty()) {
     ret->PinBodyGetter(chunk_pipe_getter);
@@ -419,53 +686,62 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
   return ret;
 }
 
-void SimpleURLLoaderWrapper::OnDataReceived(base::StringPiece string_piece,
-                                            base::OnceClosure resume) {
+void SimpleURLLoaderWrapper::OnData(std::unique_ptr<std::vector<char>> data) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
-  auto array_buffer = v8::ArrayBuffer::New(isolate, string_piece.size());
-  auto backing_store = array_buffer->GetBackingStore();
-  memcpy(backing_store->Data(), string_piece.data(), string_piece.size());
-  Emit("data", array_buffer);
-  std::move(resume).Run();
+  size_t size = data->size();
+  // Hand the buffer filled by the core over to JS without copying it.
+  auto* buffer = data.release();
+  auto backing_store = v8::ArrayBuffer::NewBackingStore(
+      buffer->data(), size,
+      [](void*, size_t, void* deleter_data) {
+        delete static_cast<std::vector<char>*>(deleter_data);
+      },
+      buffer);
+  auto array_buffer = v8::ArrayBuffer::New(isolate, std::move(backing_store));
+  Emit("data", v8::Uint8Array::New(array_buffer, 0, size));
+  if (core_) {
+    // Unretained is safe because |core_| is only ever deleted on
+    // |core_task_runner_|, after this task has run.
+    core_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&Core::OnDataConsumed,
+                                  base::Unretained(core_.get()), size));
+  }
 }
 
-void SimpleURLLoaderWrapper::OnComplete(bool success) {
+void SimpleURLLoaderWrapper::OnComplete(bool success, int net_error) {
   if (success) {
     Emit("complete");
   } else {
-    Emit("error", net::ErrorToString(loader_->NetError()));
+    Emit("error", net::ErrorToString(net_error));
   }
-  loader_.reset();
+  DestroyCore();
   pinned_wrapper_.Reset();
   pinned_chunk_pipe_getter_.Reset();
 }
 
-void SimpleURLLoaderWrapper::OnRetry(base::OnceClosure start_retry) {}
-
 void SimpleURLLoaderWrapper::OnResponseStarted(
     const GURL& final_url,
-    const network::mojom::URLResponseHead& response_head) {
+    network::mojom::URLResponseHeadPtr response_head) {
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   gin::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
-  dict.Set("statusCode", response_head.headers->response_code());
-  dict.Set("statusMessage", response_head.headers->GetStatusText());
-  dict.Set("httpVersion", response_head.headers->GetHttpVersion());
-  // Note that |response_head.headers| are filtered by Chromium and should not
+  dict.Set("statusCode", response_head->headers->response_code());
+  dict.Set("statusMessage", response_head->headers->GetStatusText());
+  dict.Set("httpVersion", response_head->headers->GetHttpVersion());
+  // Note that |response_head->headers| are filtered by Chromium and should not
   // be used here.
-  DCHECK(response_head.raw_request_response_info);
+  DCHECK(response_head->raw_request_response_info);
   dict.Set("rawHeaders",
-           response_head.raw_request_response_info->response_headers);
+           response_head->raw_request_response_info->response_headers);
   Emit("response-started", final_url, dict);
 }
 
 void SimpleURLLoaderWrapper::OnRedirect(
     const net::RedirectInfo& redirect_info,
-    const network::mojom::URLResponseHead& response_head,
-    std::vector<std::string>* removed_headers) {
-  Emit("redirect", redirect_info, response_head.headers.get());
+    network::mojom::URLResponseHeadPtr response_head) {
+  Emit("redirect", redirect_info, response_head->headers.get());
 }
 
 void SimpleURLLoaderWrapper::OnUploadProgress(uint64_t position,
@@ -9,10 +9,12 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "gin/wrappable.h"
 #include "net/base/auth.h"
-#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
 #include "services/network/public/mojom/network_context.mojom.h"
 #include "services/network/public/mojom/url_loader_factory.mojom-forward.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
@@ -26,8 +28,12 @@ template <typename T>
 class Handle;
 }  // namespace gin
 
+namespace net {
+struct RedirectInfo;
+}  // namespace net
+
 namespace network {
-class SimpleURLLoader;
+class PendingSharedURLLoaderFactory;
 struct ResourceRequest;
 }  // namespace network
 
@@ -38,8 +44,7 @@ namespace api {
 /** Wraps a SimpleURLLoader to make it usable from JavaScript */
 class SimpleURLLoaderWrapper
     : public gin::Wrappable<SimpleURLLoaderWrapper>,
-      public gin_helper::EventEmitterMixin<SimpleURLLoaderWrapper>,
-      public network::SimpleURLLoaderStreamConsumer {
+      public gin_helper::EventEmitterMixin<SimpleURLLoaderWrapper> {
  public:
   ~SimpleURLLoaderWrapper() override;
   static gin::Handle<SimpleURLLoaderWrapper> Create(gin::Arguments* args);
@@ -63,30 +68,38 @@ class SimpleURLLoaderWrapper
   const char* GetTypeName() override;
 
  private:
-  SimpleURLLoaderWrapper(std::unique_ptr<network::ResourceRequest> loader,
-                         network::mojom::URLLoaderFactory* url_loader_factory);
-
-  // SimpleURLLoaderStreamConsumer:
-  void OnDataReceived(base::StringPiece string_piece,
-                      base::OnceClosure resume) override;
-  void OnComplete(bool success) override;
-  void OnRetry(base::OnceClosure start_retry) override;
-
-  // SimpleURLLoader callbacks
+  class Core;
+
+  SimpleURLLoaderWrapper(
+      std::unique_ptr<network::ResourceRequest> request,
+      std::unique_ptr<network::PendingSharedURLLoaderFactory>
+          url_loader_factory,
+      const std::string& redirect_policy,
+      bool load_on_ui_thread,
+      size_t response_buffer_size,
+      const base::FilePath& save_path);
+
+  // Callbacks from |core_|, always invoked on the UI thread.
   void OnResponseStarted(const GURL& final_url,
-                         const network::mojom::URLResponseHead& response_head);
+                         network::mojom::URLResponseHeadPtr response_head);
   void OnRedirect(const net::RedirectInfo& redirect_info,
-                  const network::mojom::URLResponseHead& response_head,
-                  std::vector<std::string>* removed_headers);
+                  network::mojom::URLResponseHeadPtr response_head);
   void OnUploadProgress(uint64_t position, uint64_t total);
   void OnDownloadProgress(uint64_t current);
+  void OnData(std::unique_ptr<std::vector<char>> data);
+  void OnComplete(bool success, int net_error);
 
-  void Start();
+  void DestroyCore();
   void Pin();
   void PinBodyGetter(v8::Local<v8::Value>);
 
   uint32_t id_;
-  std::unique_ptr<network::SimpleURLLoader> loader_;
+
+  // The loader runs on |core_task_runner_|, which is the UI thread only when
+  // redirects have to be decided synchronously by JS.
+  scoped_refptr<base::SequencedTaskRunner> core_task_runner_;
+  std::unique_ptr<Core> core_;
+
   v8::Global<v8::Value> pinned_wrapper_;
   v8::Global<v8::Value> pinned_chunk_pipe_getter_;
 
@@ -4,6 +4,7 @@
 
 #include "shell/browser/api/electron_api_web_contents.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <set>
@@ -12,11 +13,13 @@
 #include <utility>
 #include <vector>
 
+#include "base/callback_helpers.h"
 #include "base/containers/id_map.h"
 #include "base/no_destructor.h"
 #include "base/optional.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/current_thread.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
@@ -53,15 +56,19 @@
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/associated_receiver.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "mojo/public/cpp/system/platform_handle.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
 #include "ppapi/buildflags/buildflags.h"
 #include "shell/browser/api/electron_api_browser_window.h"
 #include "shell/browser/api/electron_api_debugger.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/api/message_port.h"
+#include "shell/browser/api/page_capture_batch.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/child_web_contents_tracker.h"
 #include "shell/browser/electron_autofill_driver_factory.h"
@@ -93,6 +100,7 @@
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/js_profiler.h"
 #include "shell/common/language_util.h"
 #include "shell/common/mouse_util.h"
 #include "shell/common/node_includes.h"
@@ -408,6 +416,157 @@ struct UserDataLink : public base::SupportsUserData::Data {
 };
 const void* kElectronApiWebContentsKey = &kElectronApiWebContentsKey;
 
+// Capacity of the pipe streamHeapSnapshot() reads the snapshot from. The
+// renderer waits while it is full, so this bounds how much of the snapshot is
+// buffered when |on_data| can't keep up.
+constexpr uint32_t kHeapSnapshotPipeCapacity = 1024 * 1024;
+
+// Forwards the progress and data of a heap snapshot taken in the renderer to
+// the callbacks passed to takeHeapSnapshot() or streamHeapSnapshot(), and
+// settles its promise once the renderer replied and all the data was read.
+class HeapSnapshotObserver : public mojom::HeapSnapshotObserver {
+ public:
+  using ProgressCallback = base::RepeatingCallback<void(int, int)>;
+  using DataCallback = base::RepeatingCallback<void(v8::Local<v8::Value>)>;
+
+  HeapSnapshotObserver(v8::Isolate* isolate,
+                       gin_helper::Promise<void> promise,
+                       const ProgressCallback& on_progress,
+                       const DataCallback& on_data)
+      : isolate_(isolate),
+        promise_(std::move(promise)),
+        on_progress_(on_progress),
+        on_data_(on_data),
+        watcher_(FROM_HERE,
+                 mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+                 base::SequencedTaskRunnerHandle::Get()) {}
+
+  mojo::PendingAssociatedRemote<mojom::HeapSnapshotObserver>
+  BindNewEndpointAndPassRemote() {
+    return receiver_.BindNewEndpointAndPassRemote();
+  }
+
+  // Creates the pipe the snapshot is streamed through and returns its
+  // producer, which is invalid on failure.
+  mojo::ScopedDataPipeProducerHandle CreateDataPipe() {
+    const MojoCreateDataPipeOptions options = {
+        sizeof(MojoCreateDataPipeOptions), MOJO_CREATE_DATA_PIPE_FLAG_NONE, 1,
+        kHeapSnapshotPipeCapacity};
+    mojo::ScopedDataPipeProducerHandle producer;
+    if (mojo::CreateDataPipe(&options, &producer, &consumer_) !=
+        MOJO_RESULT_OK)
+      return producer;
+    watcher_.Watch(consumer_.get(), MOJO_HANDLE_SIGNAL_READABLE,
+                   base::BindRepeating(&HeapSnapshotObserver::OnDataReadable,
+                                       base::Unretained(this)));
+    watcher_.ArmOrNotify();
+    return producer;
+  }
+
+  // Takes the renderer's reply. The observer owns itself from here on and is
+  // deleted once the promise is settled.
+  void OnSnapshotTaken(bool success) {
+    success_ = success;
+    // A failed snapshot doesn't need the rest of its data; dropping the pipe
+    // makes the renderer stop writing.
+    if (!success)
+      consumer_.reset();
+    MaybeFinish();
+  }
+
+  // mojom::HeapSnapshotObserver
+  void OnProgress(int32_t done, int32_t total) override {
+    if (on_progress_)
+      on_progress_.Run(done, total);
+  }
+
+ private:
+  // Reads one chunk per notification so that a fast renderer can't starve
+  // the rest of the main thread.
+  void OnDataReadable(MojoResult result) {
+    if (result == MOJO_RESULT_OK) {
+      const void* buffer;
+      uint32_t size;
+      result =
+          consumer_->BeginReadData(&buffer, &size, MOJO_READ_DATA_FLAG_NONE);
+      if (result == MOJO_RESULT_OK) {
+        {
+          v8::HandleScope handle_scope(isolate_);
+          v8::Local<v8::Value> chunk =
+              node::Buffer::Copy(isolate_, static_cast<const char*>(buffer),
+                                 size)
+                  .ToLocalChecked();
+          consumer_->EndReadData(size);
+          on_data_.Run(chunk);
+        }
+        watcher_.ArmOrNotify();
+        return;
+      }
+      if (result == MOJO_RESULT_SHOULD_WAIT) {
+        watcher_.ArmOrNotify();
+        return;
+      }
+    }
+
+    // The renderer closed its end, so everything has been read.
+    watcher_.Cancel();
+    consumer_.reset();
+    MaybeFinish();
+  }
+
+  void MaybeFinish() {
+    if (!success_ || consumer_.is_valid())
+      return;
+    if (*success_)
+      promise_.Resolve();
+    else
+      promise_.RejectWithErrorMessage("takeHeapSnapshot failed");
+    delete this;
+  }
+
+  v8::Isolate* isolate_;
+  gin_helper::Promise<void> promise_;
+  ProgressCallback on_progress_;
+  DataCallback on_data_;
+  base::Optional<bool> success_;
+  mojo::ScopedDataPipeConsumerHandle consumer_;
+  mojo::SimpleWatcher watcher_;
+  mojo::AssociatedReceiver<mojom::HeapSnapshotObserver> receiver_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotObserver);
+};
+
+// Binds a new remote to the ElectronRenderer of |frame_host|. Callers keep
+// it alive with `base::Owned` until its reply arrives.
+std::unique_ptr<mojo::AssociatedRemote<mojom::ElectronRenderer>>
+BindElectronRenderer(content::RenderFrameHost* frame_host) {
+  auto electron_renderer =
+      std::make_unique<mojo::AssociatedRemote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+      electron_renderer.get());
+  return electron_renderer;
+}
+
+void OnProfilingStarted(mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
+                        gin_helper::Promise<void> promise,
+                        const char* error,
+                        bool success) {
+  if (success)
+    promise.Resolve();
+  else
+    promise.RejectWithErrorMessage(error);
+}
+
+void OnProfilingStopped(mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
+                        gin_helper::Promise<std::string> promise,
+                        const char* error,
+                        const base::Optional<std::string>& profile) {
+  if (profile)
+    promise.Resolve(*profile);
+  else
+    promise.RejectWithErrorMessage(error);
+}
+
 }  // namespace
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -2539,13 +2698,8 @@ v8::Local<v8::Promise> WebContents::CapturePage(gin::Arguments* args) {
   // By default, the requested bitmap size is the view size in screen
   // coordinates.  However, if there's more pixel detail available on the
   // current system, increase the requested bitmap size to capture it all.
-  gfx::Size bitmap_size = view_size;
-  const gfx::NativeView native_view = view->GetNativeView();
-  const float scale = display::Screen::GetScreen()
-                          ->GetDisplayNearestView(native_view)
-                          .device_scale_factor();
-  if (scale > 1.0f)
-    bitmap_size = gfx::ScaleToCeiledSize(view_size, scale);
+  const gfx::Size bitmap_size =
+      PageCaptureBatch::GetOutputSize(view, rect, base::nullopt);
 
   view->CopyFromSurface(gfx::Rect(rect.origin(), view_size), bitmap_size,
                         base::BindOnce(&OnCapturePageDone, std::move(promise)));
@@ -2819,47 +2973,241 @@ void WebContents::NotifyUserActivation() {
 
 v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
     v8::Isolate* isolate,
-    const base::FilePath& file_path) {
-  gin_helper::Promise<void> promise(isolate);
-  v8::Local<v8::Promise> handle = promise.GetHandle();
-
+    const base::FilePath& file_path,
+    gin::Arguments* args) {
   base::ThreadRestrictions::ScopedAllowIO allow_io;
   base::File file(file_path,
                   base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
   if (!file.IsValid()) {
+    gin_helper::Promise<void> promise(isolate);
+    v8::Local<v8::Promise> handle = promise.GetHandle();
     promise.RejectWithErrorMessage("takeHeapSnapshot failed");
     return handle;
   }
 
+  return RequestHeapSnapshot(isolate, std::move(file), base::NullCallback(),
+                             args);
+}
+
+v8::Local<v8::Promise> WebContents::StreamHeapSnapshot(
+    v8::Isolate* isolate,
+    const base::RepeatingCallback<void(v8::Local<v8::Value>)>& on_data,
+    gin::Arguments* args) {
+  return RequestHeapSnapshot(isolate, base::File(), on_data, args);
+}
+
+v8::Local<v8::Promise> WebContents::RequestHeapSnapshot(
+    v8::Isolate* isolate,
+    base::File file,
+    const base::RepeatingCallback<void(v8::Local<v8::Value>)>& on_data,
+    gin::Arguments* args) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  bool compress = false;
+  base::RepeatingCallback<void(int, int)> on_progress;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("compress", &compress);
+    options.Get("onProgress", &on_progress);
+  }
+
   auto* frame_host = web_contents()->GetMainFrame();
   if (!frame_host) {
     promise.RejectWithErrorMessage("takeHeapSnapshot failed");
     return handle;
   }
 
+  mojo::ScopedHandle file_handle;
+  if (file.IsValid())
+    file_handle = mojo::WrapPlatformFile(file.TakePlatformFile());
+
+  auto observer = std::make_unique<HeapSnapshotObserver>(
+      isolate, std::move(promise), on_progress, on_data);
+  mojo::PendingAssociatedRemote<mojom::HeapSnapshotObserver> observer_remote;
+  if (on_progress)
+    observer_remote = observer->BindNewEndpointAndPassRemote();
+  mojo::ScopedDataPipeProducerHandle data_producer;
+  if (on_data) {
+    data_producer = observer->CreateDataPipe();
+    if (!data_producer.is_valid()) {
+      observer.release()->OnSnapshotTaken(false);
+      return handle;
+    }
+  }
+
   // This dance with `base::Owned` is to ensure that the interface stays alive
   // until the callback is called. Otherwise it would be closed at the end of
-  // this function.
+  // this function. The observer is passed along the same way, and takes care
+  // of itself once the reply arrives.
   auto electron_renderer =
       std::make_unique<mojo::AssociatedRemote<mojom::ElectronRenderer>>();
   frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
       electron_renderer.get());
   auto* raw_ptr = electron_renderer.get();
   (*raw_ptr)->TakeHeapSnapshot(
-      mojo::WrapPlatformFile(file.TakePlatformFile()),
+      std::move(file_handle), std::move(data_producer), compress,
+      std::move(observer_remote),
       base::BindOnce(
           [](mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
-             gin_helper::Promise<void> promise, bool success) {
-            if (success) {
-              promise.Resolve();
-            } else {
-              promise.RejectWithErrorMessage("takeHeapSnapshot failed");
-            }
+             std::unique_ptr<HeapSnapshotObserver> observer, bool success) {
+            observer.release()->OnSnapshotTaken(success);
           },
-          base::Owned(std::move(electron_renderer)), std::move(promise)));
+          base::Owned(std::move(electron_renderer)), std::move(observer)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::GetResourceUsage(v8::Isolate* isolate) {
+  gin_helper::Promise<gin_helper::Dictionary> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage("The renderer process is not running");
+    return handle;
+  }
+
+  // A renderer process may host several WebContents, in which case its JS
+  // heap and Blink caches are shared between all of them.
+  auto* process = frame_host->GetProcess();
+  size_t shared_view_count = process->GetActiveViewCount();
+  base::ProcessId pid = base::GetProcId(process->GetProcess().Handle());
+
+  auto electron_renderer =
+      std::make_unique<mojo::AssociatedRemote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+      electron_renderer.get());
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->GetResourceUsage(base::BindOnce(
+      [](mojo::AssociatedRemote<mojom::ElectronRenderer>* ep,
+         gin_helper::Promise<gin_helper::Dictionary> promise,
+         base::ProcessId pid, size_t shared_view_count,
+         uint64_t network_request_count, uint64_t network_bytes_received,
+         mojom::RendererResourceUsagePtr usage) {
+        v8::Isolate* isolate = promise.isolate();
+        v8::HandleScope handle_scope(isolate);
+        gin_helper::Dictionary js_heap = gin::Dictionary::CreateEmpty(isolate);
+        js_heap.Set("usedSize", static_cast<double>(usage->js_heap_used_size));
+        js_heap.Set("totalSize",
+                    static_cast<double>(usage->js_heap_total_size));
+        gin_helper::Dictionary network = gin::Dictionary::CreateEmpty(isolate);
+        network.Set("requestCount",
+                    static_cast<double>(network_request_count));
+        network.Set("bytesReceived",
+                    static_cast<double>(network_bytes_received));
+        gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+        dict.Set("pid", pid);
+        dict.Set("sharedViewCount", static_cast<int>(shared_view_count));
+        dict.Set("jsHeap", js_heap);
+        dict.Set("blinkCacheSize",
+                 static_cast<double>(usage->blink_cache_size));
+        dict.Set("network", network);
+        promise.Resolve(dict);
+      },
+      base::Owned(std::move(electron_renderer)), std::move(promise), pid,
+      shared_view_count, network_request_count_, network_bytes_received_));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StartCpuProfiling(gin::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  base::TimeDelta sampling_interval;
+  std::string error;
+  if (!GetCpuProfilingOptions(args, &sampling_interval, &error)) {
+    promise.RejectWithErrorMessage(error);
+    return handle;
+  }
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage("The renderer process is not running");
+    return handle;
+  }
+
+  auto electron_renderer = BindElectronRenderer(frame_host);
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StartCpuProfiling(
+      sampling_interval.InMicroseconds(),
+      base::BindOnce(&OnProfilingStarted,
+                     base::Owned(std::move(electron_renderer)),
+                     std::move(promise),
+                     "CPU profiling has already been started"));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StopCpuProfiling(v8::Isolate* isolate) {
+  gin_helper::Promise<std::string> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage("The renderer process is not running");
+    return handle;
+  }
+
+  auto electron_renderer = BindElectronRenderer(frame_host);
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StopCpuProfiling(base::BindOnce(
+      &OnProfilingStopped, base::Owned(std::move(electron_renderer)),
+      std::move(promise), "CPU profiling has not been started"));
   return handle;
 }
 
+v8::Local<v8::Promise> WebContents::StartHeapProfiling(gin::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  uint64_t sampling_interval;
+  int stack_depth;
+  std::string error;
+  if (!GetHeapProfilingOptions(args, &sampling_interval, &stack_depth,
+                               &error)) {
+    promise.RejectWithErrorMessage(error);
+    return handle;
+  }
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage("The renderer process is not running");
+    return handle;
+  }
+
+  auto electron_renderer = BindElectronRenderer(frame_host);
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StartHeapProfiling(
+      sampling_interval, stack_depth,
+      base::BindOnce(&OnProfilingStarted,
+                     base::Owned(std::move(electron_renderer)),
+                     std::move(promise),
+                     "Heap profiling has already been started"));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StopHeapProfiling(v8::Isolate* isolate) {
+  gin_helper::Promise<std::string> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage("The renderer process is not running");
+    return handle;
+  }
+
+  auto electron_renderer = BindElectronRenderer(frame_host);
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StopHeapProfiling(base::BindOnce(
+      &OnProfilingStopped, base::Owned(std::move(electron_renderer)),
+      std::move(promise), "Heap profiling has not been started"));
+  return handle;
+}
+
+void WebContents::AddNetworkUsage(int64_t bytes_received) {
+  network_request_count_++;
+  network_bytes_received_ += std::max<int64_t>(bytes_received, 0);
+}
+
 // static
 v8::Local<v8::ObjectTemplate> WebContents::FillObjectTemplate(
     v8::Isolate* isolate,
@@ -2990,6 +3338,12 @@ v8::Local<v8::ObjectTemplate> WebContents::FillObjectTemplate(
                  &WebContents::GetWebRTCIPHandlingPolicy)
       .SetMethod("_grantOriginAccess", &WebContents::GrantOriginAccess)
       .SetMethod("takeHeapSnapshot", &WebContents::TakeHeapSnapshot)
+      .SetMethod("streamHeapSnapshot", &WebContents::StreamHeapSnapshot)
+      .SetMethod("getResourceUsage", &WebContents::GetResourceUsage)
+      .SetMethod("startCpuProfiling", &WebContents::StartCpuProfiling)
+      .SetMethod("stopCpuProfiling", &WebContents::StopCpuProfiling)
+      .SetMethod("startHeapProfiling", &WebContents::StartHeapProfiling)
+      .SetMethod("stopHeapProfiling", &WebContents::StopHeapProfiling)
       .SetProperty("id", &WebContents::ID)
       .SetProperty("session", &WebContents::Session)
       .SetProperty("hostWebContents", &WebContents::HostWebContents)
@@ -3084,6 +3438,69 @@ std::vector<gin::Handle<WebContents>> GetAllWebContentsAsV8(
   return list;
 }
 
+v8::Local<v8::Promise> CapturePages(gin::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::vector<gin_helper::Dictionary> requests;
+  if (!args->GetNext(&requests)) {
+    promise.RejectWithErrorMessage("Must pass an array of capture requests");
+    return handle;
+  }
+
+  std::vector<std::pair<WebContents*, PageCaptureBatch::Options>> captures;
+  for (const auto& request : requests) {
+    WebContents* contents = nullptr;
+    if (!request.Get("webContents", &contents) || !contents) {
+      promise.RejectWithErrorMessage(
+          "Each capture request must specify 'webContents'");
+      return handle;
+    }
+
+    PageCaptureBatch::Options options;
+    request.Get("rect", &options.rect);
+    float scale_factor;
+    if (request.Get("scaleFactor", &scale_factor)) {
+      if (scale_factor <= 0.0f) {
+        promise.RejectWithErrorMessage("'scaleFactor' must be positive");
+        return handle;
+      }
+      options.scale_factor = scale_factor;
+    }
+    std::string encoding;
+    if (request.Get("encoding", &encoding)) {
+      if (encoding == "png") {
+        options.encoding = PageCaptureBatch::Encoding::kPNG;
+      } else if (encoding == "jpeg") {
+        options.encoding = PageCaptureBatch::Encoding::kJPEG;
+      } else if (encoding != "none") {
+        promise.RejectWithErrorMessage("Invalid encoding: " + encoding);
+        return handle;
+      }
+    }
+    request.Get("quality", &options.quality);
+    captures.emplace_back(contents, options);
+  }
+
+  if (captures.empty()) {
+    promise.Resolve(v8::Array::New(isolate));
+    return handle;
+  }
+
+  auto batch = base::MakeRefCounted<PageCaptureBatch>(std::move(promise),
+                                                      captures.size());
+  for (size_t i = 0; i < captures.size(); ++i) {
+    WebContents* contents = captures[i].first;
+    content::RenderWidgetHostView* view =
+        contents->web_contents()
+            ? contents->web_contents()->GetRenderWidgetHostView()
+            : nullptr;
+    batch->Capture(i, view, captures[i].second);
+  }
+  return handle;
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -3094,6 +3511,7 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("create", &WebContents::Create);
   dict.SetMethod("fromId", &WebContents::FromID);
   dict.SetMethod("getAllWebContents", &GetAllWebContentsAsV8);
+  dict.SetMethod("capturePages", &CapturePages);
 }
 
 }  // namespace
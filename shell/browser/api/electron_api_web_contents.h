@@ -11,6 +11,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/files/file.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
 #include "content/common/cursors/webcursor.h"
@@ -387,7 +388,23 @@ class WebContents : public gin::Wrappable<WebContents>,
   void NotifyUserActivation();
 
   v8::Local<v8::Promise> TakeHeapSnapshot(v8::Isolate* isolate,
-                                          const base::FilePath& file_path);
+                                          const base::FilePath& file_path,
+                                          gin::Arguments* args);
+  v8::Local<v8::Promise> StreamHeapSnapshot(
+      v8::Isolate* isolate,
+      const base::RepeatingCallback<void(v8::Local<v8::Value>)>& on_data,
+      gin::Arguments* args);
+
+  v8::Local<v8::Promise> GetResourceUsage(v8::Isolate* isolate);
+
+  v8::Local<v8::Promise> StartCpuProfiling(gin::Arguments* args);
+  v8::Local<v8::Promise> StopCpuProfiling(v8::Isolate* isolate);
+  v8::Local<v8::Promise> StartHeapProfiling(gin::Arguments* args);
+  v8::Local<v8::Promise> StopHeapProfiling(v8::Isolate* isolate);
+
+  // Called by ProxyingURLLoaderFactory when a request made by one of our
+  // frames completes.
+  void AddNetworkUsage(int64_t bytes_received);
 
   // Properties.
   int32_t ID() const { return id_; }
@@ -618,6 +635,14 @@ class WebContents : public gin::Wrappable<WebContents>,
 
   uint32_t GetNextRequestId() { return ++request_id_; }
 
+  // Asks the renderer for a heap snapshot, written to |file| if it is valid
+  // and passed to |on_data| in chunks otherwise.
+  v8::Local<v8::Promise> RequestHeapSnapshot(
+      v8::Isolate* isolate,
+      base::File file,
+      const base::RepeatingCallback<void(v8::Local<v8::Value>)>& on_data,
+      gin::Arguments* args);
+
 #if BUILDFLAG(ENABLE_OSR)
   OffScreenWebContentsView* GetOffScreenWebContentsView() const override;
   OffScreenRenderWidgetHostView* GetOffScreenRenderWidgetHostView() const;
@@ -704,6 +729,10 @@ class WebContents : public gin::Wrappable<WebContents>,
   std::map<content::RenderFrameHost*, std::vector<mojo::ReceiverId>>
       frame_to_receivers_map_;
 
+  // Network usage of requests made by the frames of this WebContents.
+  uint64_t network_request_count_ = 0;
+  uint64_t network_bytes_received_ = 0;
+
   base::WeakPtrFactory<WebContents> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(WebContents);
@@ -0,0 +1,172 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/page_capture_batch.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/task/thread_pool.h"
+#include "content/public/browser/render_widget_host_view.h"
+#include "gin/handle.h"
+#include "shell/common/api/electron_api_native_image.h"
+#include "shell/common/gin_converters/gfx_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/locker.h"
+#include "shell/common/node_includes.h"
+#include "ui/display/display.h"
+#include "ui/display/screen.h"
+#include "ui/gfx/codec/jpeg_codec.h"
+#include "ui/gfx/codec/png_codec.h"
+#include "ui/gfx/geometry/size_conversions.h"
+#include "ui/gfx/image/image.h"
+
+namespace electron {
+
+namespace api {
+
+PageCaptureBatch::Options::Options() = default;
+PageCaptureBatch::Options::Options(const Options&) = default;
+PageCaptureBatch::Options::~Options() = default;
+
+PageCaptureBatch::Result::Result() = default;
+PageCaptureBatch::Result::Result(Result&&) = default;
+PageCaptureBatch::Result& PageCaptureBatch::Result::operator=(Result&&) =
+    default;
+PageCaptureBatch::Result::~Result() = default;
+
+PageCaptureBatch::PageCaptureBatch(
+    gin_helper::Promise<v8::Local<v8::Value>> promise,
+    size_t count)
+    : promise_(std::move(promise)), results_(count), pending_(count) {}
+
+PageCaptureBatch::~PageCaptureBatch() = default;
+
+// static
+gfx::Size PageCaptureBatch::GetOutputSize(content::RenderWidgetHostView* view,
+                                          const gfx::Rect& rect,
+                                          base::Optional<float> scale_factor) {
+  // Capture full page if user doesn't specify a |rect|.
+  const gfx::Size view_size =
+      rect.IsEmpty() ? view->GetViewBounds().size() : rect.size();
+
+  float scale = 1.0f;
+  if (scale_factor) {
+    scale = *scale_factor;
+  } else {
+    // By default use the scale factor of the display so that all the pixel
+    // detail available on the current system is captured.
+    scale = display::Screen::GetScreen()
+                ->GetDisplayNearestView(view->GetNativeView())
+                .device_scale_factor();
+    if (scale < 1.0f)
+      scale = 1.0f;
+  }
+  if (scale == 1.0f)
+    return view_size;
+  return gfx::ScaleToCeiledSize(view_size, scale);
+}
+
+void PageCaptureBatch::Capture(size_t index,
+                               content::RenderWidgetHostView* view,
+                               const Options& options) {
+  DCHECK_LT(index, results_.size());
+  if (!view) {
+    Result result;
+    result.encoding = options.encoding;
+    Done(index, std::move(result));
+    return;
+  }
+
+  const gfx::Rect& rect = options.rect;
+  gfx::Size output_size = GetOutputSize(view, rect, options.scale_factor);
+  gfx::Rect src_rect(rect.origin(), rect.IsEmpty()
+                                        ? view->GetViewBounds().size()
+                                        : rect.size());
+  view->CopyFromSurface(
+      src_rect, output_size,
+      base::BindOnce(&PageCaptureBatch::OnCopied, base::WrapRefCounted(this),
+                     index, options.encoding, options.quality,
+                     base::TimeTicks::Now()));
+}
+
+void PageCaptureBatch::OnCopied(size_t index,
+                                Encoding encoding,
+                                int quality,
+                                base::TimeTicks start_time,
+                                const SkBitmap& bitmap) {
+  Result result;
+  result.encoding = encoding;
+  result.size = gfx::Size(bitmap.width(), bitmap.height());
+  result.capture_time = base::TimeTicks::Now() - start_time;
+  result.bitmap = bitmap;
+
+  if (encoding == Encoding::kNone || bitmap.drawsNothing()) {
+    Done(index, std::move(result));
+    return;
+  }
+
+  // The bitmap is not touched again on this thread, so it can be handed to
+  // the worker without copying the pixels.
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&PageCaptureBatch::Encode, std::move(result), quality),
+      base::BindOnce(&PageCaptureBatch::Done, base::WrapRefCounted(this),
+                     index));
+}
+
+// static
+PageCaptureBatch::Result PageCaptureBatch::Encode(Result result, int quality) {
+  base::TimeTicks start_time = base::TimeTicks::Now();
+  if (result.encoding == Encoding::kPNG)
+    gfx::PNGCodec::EncodeBGRASkBitmap(result.bitmap, false, &result.encoded);
+  else if (result.encoding == Encoding::kJPEG)
+    gfx::JPEGCodec::Encode(result.bitmap, quality, &result.encoded);
+  result.bitmap.reset();
+  result.encode_time = base::TimeTicks::Now() - start_time;
+  return result;
+}
+
+void PageCaptureBatch::Done(size_t index, Result result) {
+  results_[index] = std::move(result);
+  DCHECK_GT(pending_, 0u);
+  if (--pending_ == 0)
+    Finish();
+}
+
+void PageCaptureBatch::Finish() {
+  v8::Isolate* isolate = promise_.isolate();
+  gin_helper::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise_.GetContext());
+
+  v8::Local<v8::Array> list = v8::Array::New(isolate, results_.size());
+  for (size_t i = 0; i < results_.size(); ++i) {
+    Result& result = results_[i];
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    if (result.encoding == Encoding::kNone) {
+      dict.Set("image",
+               NativeImage::Create(
+                   isolate, gfx::Image::CreateFrom1xBitmap(result.bitmap)));
+    } else {
+      const char* data = reinterpret_cast<const char*>(result.encoded.data());
+      dict.Set("data",
+               node::Buffer::Copy(isolate, data, result.encoded.size())
+                   .ToLocalChecked());
+    }
+    dict.Set("size", result.size);
+    dict.Set("captureTime", result.capture_time.InMillisecondsF());
+    dict.Set("encodeTime", result.encode_time.InMillisecondsF());
+    list->Set(promise_.GetContext(), i, dict.GetHandle()).Check();
+  }
+  results_.clear();
+
+  promise_.Resolve(list);
+}
+
+}  // namespace api
+
+}  // namespace electron
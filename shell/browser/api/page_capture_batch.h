@@ -0,0 +1,106 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_PAGE_CAPTURE_BATCH_H_
+#define SHELL_BROWSER_API_PAGE_CAPTURE_BATCH_H_
+
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/optional.h"
+#include "base/time/time.h"
+#include "shell/common/gin_helper/promise.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/size.h"
+#include "v8/include/v8.h"
+
+namespace content {
+class RenderWidgetHostView;
+}
+
+namespace electron {
+
+namespace api {
+
+// Captures a set of pages and resolves a single promise once every capture
+// has finished. Surface copies happen at the requested output size, and
+// encoding of the resulting bitmaps is done on the thread pool so the UI
+// thread only pays for issuing the copy requests.
+class PageCaptureBatch : public base::RefCounted<PageCaptureBatch> {
+ public:
+  enum class Encoding {
+    kNone,
+    kPNG,
+    kJPEG,
+  };
+
+  struct Options {
+    Options();
+    Options(const Options&);
+    ~Options();
+
+    gfx::Rect rect;
+    // Output scale relative to the view size in DIPs. Uses the scale factor
+    // of the display the view is on when unset.
+    base::Optional<float> scale_factor;
+    Encoding encoding = Encoding::kNone;
+    int quality = 90;
+  };
+
+  PageCaptureBatch(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                   size_t count);
+
+  // Issues the capture for the |index|th item. A null |view| produces an
+  // empty result.
+  void Capture(size_t index,
+               content::RenderWidgetHostView* view,
+               const Options& options);
+
+  // Computes the bitmap size used when copying |rect| from |view|.
+  static gfx::Size GetOutputSize(content::RenderWidgetHostView* view,
+                                 const gfx::Rect& rect,
+                                 base::Optional<float> scale_factor);
+
+ private:
+  friend class base::RefCounted<PageCaptureBatch>;
+
+  struct Result {
+    Result();
+    Result(Result&&);
+    Result& operator=(Result&&);
+    ~Result();
+
+    Encoding encoding = Encoding::kNone;
+    SkBitmap bitmap;
+    std::vector<unsigned char> encoded;
+    gfx::Size size;
+    base::TimeDelta capture_time;
+    base::TimeDelta encode_time;
+  };
+
+  ~PageCaptureBatch();
+
+  void OnCopied(size_t index,
+                Encoding encoding,
+                int quality,
+                base::TimeTicks start_time,
+                const SkBitmap& bitmap);
+  // Runs on the thread pool.
+  static Result Encode(Result result, int quality);
+  void Done(size_t index, Result result);
+  void Finish();
+
+  gin_helper::Promise<v8::Local<v8::Value>> promise_;
+  std::vector<Result> results_;
+  size_t pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(PageCaptureBatch);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_API_PAGE_CAPTURE_BATCH_H_
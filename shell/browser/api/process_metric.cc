@@ -5,7 +5,9 @@
 #include "shell/browser/api/process_metric.h"
 
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/optional.h"
 
@@ -48,6 +50,42 @@ base::Optional<mach_task_basic_info_data_t> GetTaskInfo(mach_port_t task) {
 
 #endif  // defined(OS_MAC)
 
+#if defined(OS_LINUX)
+#include <unistd.h>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+
+namespace {
+
+// Calls |callback| with the name and the value in bytes of each
+// "Name:   1234 kB" line in the procfs file at |path|.
+template <typename Callback>
+bool ReadProcKiBValues(const std::string& path, Callback callback) {
+  std::string content;
+  if (!base::ReadFileToString(base::FilePath(path), &content))
+    return false;
+  for (base::StringPiece line : base::SplitStringPiece(
+           content, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    std::vector<base::StringPiece> fields = base::SplitStringPiece(
+        line, " \t", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    size_t value;
+    if (fields.size() != 3 || fields[2] != "kB" ||
+        !base::StringToSizeT(fields[1], &value))
+      continue;
+    callback(fields[0], value << 10);
+  }
+  return true;
+}
+
+}  // namespace
+
+#endif  // defined(OS_LINUX)
+
 namespace electron {
 
 ProcessMetric::ProcessMetric(int type,
@@ -165,6 +203,60 @@ bool ProcessMetric::IsSandboxed() const {
 #endif
 }
 
-#endif  // defined(OS_MAC)
+#elif defined(OS_LINUX)
+
+// static
+ProcessMemoryInfo ProcessMetric::ReadMemoryInfo(base::ProcessId pid) {
+  ProcessMemoryInfo result;
+
+  // smaps_rollup (Linux 4.14+) sums smaps over all mappings in the kernel,
+  // which is much cheaper than parsing smaps.
+  bool has_rollup = ReadProcKiBValues(
+      base::StringPrintf("/proc/%d/smaps_rollup", pid),
+      [&result](base::StringPiece name, size_t value) {
+        if (name == "Rss:")
+          result.working_set_size = value;
+        else if (name == "Pss:")
+          result.proportional_set_size = value;
+        else if (name == "Shared_Dirty:")
+          result.shared_dirty = value;
+        else if (name == "Private_Dirty:")
+          result.private_dirty = value;
+        else if (name == "Swap:")
+          result.swap = value;
+      });
+  result.has_smaps_rollup = has_rollup;
+
+  ReadProcKiBValues(base::StringPrintf("/proc/%d/status", pid),
+                    [&result, has_rollup](base::StringPiece name,
+                                          size_t value) {
+                      if (name == "VmHWM:")
+                        result.peak_working_set_size = value;
+                      else if (!has_rollup && name == "VmRSS:")
+                        result.working_set_size = value;
+                      else if (!has_rollup && name == "VmSwap:")
+                        result.swap = value;
+                    });
+
+  return result;
+}
+
+// static
+size_t ProcessMetric::ReadResidentSetSize(base::ProcessId pid) {
+  // statm holds a handful of page counts, the second of which is the RSS.
+  // Unlike smaps_rollup, reading it doesn't walk the process' mappings.
+  std::string content;
+  if (!base::ReadFileToString(
+          base::FilePath(base::StringPrintf("/proc/%d/statm", pid)), &content))
+    return 0;
+  std::vector<base::StringPiece> fields = base::SplitStringPiece(
+      content, " \n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  size_t pages;
+  if (fields.size() < 2 || !base::StringToSizeT(fields[1], &pages))
+    return 0;
+  return pages * sysconf(_SC_PAGESIZE);
+}
+
+#endif  // defined(OS_LINUX)
 
 }  // namespace electron
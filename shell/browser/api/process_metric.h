@@ -8,21 +8,29 @@
 #include <memory>
 #include <string>
 
+#include "base/optional.h"
 #include "base/process/process.h"
 #include "base/process/process_handle.h"
 #include "base/process/process_metrics.h"
 
 namespace electron {
 
-#if !defined(OS_LINUX)
 struct ProcessMemoryInfo {
   size_t working_set_size = 0;
   size_t peak_working_set_size = 0;
 #if defined(OS_WIN)
   size_t private_bytes = 0;
+#elif defined(OS_LINUX)
+  // Whether the fields below, except |swap|, were read. They need
+  // /proc/<pid>/smaps_rollup, which older kernels lack.
+  bool has_smaps_rollup = false;
+  size_t proportional_set_size = 0;
+  size_t peak_proportional_set_size = 0;
+  size_t private_dirty = 0;
+  size_t shared_dirty = 0;
+  size_t swap = 0;
 #endif
 };
-#endif
 
 #if defined(OS_WIN)
 enum class ProcessIntegrityLevel {
@@ -46,7 +54,15 @@ struct ProcessMetric {
                 const std::string& name = std::string());
   ~ProcessMetric();
 
-#if !defined(OS_LINUX)
+#if defined(OS_LINUX)
+  // Reading procfs blocks, so on Linux the memory info is sampled on a
+  // background sequence with ReadMemoryInfo() and cached here.
+  base::Optional<ProcessMemoryInfo> memory_info;
+
+  static ProcessMemoryInfo ReadMemoryInfo(base::ProcessId pid);
+  // Cheap enough to be sampled periodically, in bytes. 0 on failure.
+  static size_t ReadResidentSetSize(base::ProcessId pid);
+#else
   ProcessMemoryInfo GetMemoryInfo() const;
 #endif
 
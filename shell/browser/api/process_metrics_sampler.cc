@@ -0,0 +1,214 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/process_metrics_sampler.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/system/sys_info.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/timer/timer.h"
+#include "content/public/common/process_type.h"
+#include "shell/browser/api/process_metric.h"
+#include "shell/common/gin_helper/dictionary.h"
+
+#if defined(OS_WIN)
+#include <windows.h>
+#endif
+
+namespace electron {
+
+namespace {
+
+double GetHandleCount(const ProcessMetric& process_metric) {
+#if defined(OS_WIN)
+  DWORD handle_count = 0;
+  if (!::GetProcessHandleCount(process_metric.process.Handle(), &handle_count))
+    return std::numeric_limits<double>::quiet_NaN();
+  return handle_count;
+#else
+  int fd_count = process_metric.metrics->GetOpenFdCount();
+  return fd_count < 0 ? std::numeric_limits<double>::quiet_NaN() : fd_count;
+#endif
+}
+
+v8::Local<v8::Float64Array> CreateFloat64Array(v8::Isolate* isolate,
+                                               size_t length,
+                                               double** data) {
+  auto buffer = v8::ArrayBuffer::New(isolate, length * sizeof(double));
+  *data = static_cast<double*>(buffer->GetBackingStore()->Data());
+  std::fill(*data, *data + length, std::numeric_limits<double>::quiet_NaN());
+  return v8::Float64Array::New(buffer, 0, length);
+}
+
+}  // namespace
+
+ProcessMetricsSampler::Sample::Sample() = default;
+ProcessMetricsSampler::Sample::Sample(Sample&&) = default;
+ProcessMetricsSampler::Sample::~Sample() = default;
+ProcessMetricsSampler::Sample& ProcessMetricsSampler::Sample::operator=(
+    Sample&&) = default;
+
+// Owns the sampled processes' ProcessMetrics on |task_runner_|, since their
+// CPU usage is computed from the state left by the previous call.
+class ProcessMetricsSampler::Core {
+ public:
+  explicit Core(base::WeakPtr<ProcessMetricsSampler> sampler)
+      : sampler_(sampler),
+        ui_task_runner_(base::SequencedTaskRunnerHandle::Get()),
+        processor_count_(base::SysInfo::NumberOfProcessors()) {}
+
+  void Start(base::TimeDelta interval) {
+    timer_.Start(FROM_HERE, interval,
+                 base::BindRepeating(&Core::TakeSample, base::Unretained(this)));
+  }
+
+  void AddProcess(std::unique_ptr<ProcessMetric> process_metric) {
+    // Prime the CPU usage, whose first reading is always 0.
+    process_metric->metrics->GetPlatformIndependentCPUUsage();
+    base::ProcessId pid = process_metric->process.Pid();
+    processes_[pid] = std::move(process_metric);
+  }
+
+  void RemoveProcess(base::ProcessId pid) { processes_.erase(pid); }
+
+ private:
+  void TakeSample() {
+    Sample sample;
+    sample.time = base::Time::Now();
+    sample.entries.reserve(processes_.size());
+    for (const auto& it : processes_) {
+      const ProcessMetric& process_metric = *it.second;
+      Entry entry;
+      entry.pid = it.first;
+      entry.type = process_metric.type;
+      entry.cpu_usage =
+          process_metric.metrics->GetPlatformIndependentCPUUsage() /
+          processor_count_;
+#if defined(OS_WIN)
+      entry.idle_wakeups = 0;
+#else
+      entry.idle_wakeups = process_metric.metrics->GetIdleWakeupsPerSecond();
+#endif
+#if defined(OS_LINUX)
+      entry.working_set_size =
+          ProcessMetric::ReadResidentSetSize(it.first) >> 10;
+#else
+      entry.working_set_size =
+          process_metric.GetMemoryInfo().working_set_size >> 10;
+#endif
+      entry.handle_count = GetHandleCount(process_metric);
+      sample.entries.push_back(entry);
+    }
+    ui_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&ProcessMetricsSampler::OnSample, sampler_,
+                                  std::move(sample)));
+  }
+
+  base::WeakPtr<ProcessMetricsSampler> sampler_;
+  scoped_refptr<base::SequencedTaskRunner> ui_task_runner_;
+  const int processor_count_;
+
+  std::map<base::ProcessId, std::unique_ptr<ProcessMetric>> processes_;
+  base::RepeatingTimer timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(Core);
+};
+
+ProcessMetricsSampler::ProcessMetricsSampler(base::TimeDelta interval,
+                                             size_t history_size)
+    : history_size_(history_size),
+      task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {
+  core_ = std::make_unique<Core>(weak_factory_.GetWeakPtr());
+  // Unretained is safe because |core_| is only deleted on |task_runner_|,
+  // after every task posted to it here.
+  task_runner_->PostTask(FROM_HERE,
+                         base::BindOnce(&Core::Start,
+                                        base::Unretained(core_.get()),
+                                        interval));
+}
+
+ProcessMetricsSampler::~ProcessMetricsSampler() {
+  task_runner_->DeleteSoon(FROM_HERE, std::move(core_));
+}
+
+void ProcessMetricsSampler::AddProcess(
+    std::unique_ptr<ProcessMetric> process_metric) {
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&Core::AddProcess, base::Unretained(core_.get()),
+                                std::move(process_metric)));
+}
+
+void ProcessMetricsSampler::RemoveProcess(base::ProcessId pid) {
+  task_runner_->PostTask(FROM_HERE,
+                         base::BindOnce(&Core::RemoveProcess,
+                                        base::Unretained(core_.get()), pid));
+}
+
+void ProcessMetricsSampler::OnSample(Sample sample) {
+  if (history_.size() == history_size_)
+    history_.pop_front();
+  history_.push_back(std::move(sample));
+}
+
+v8::Local<v8::Value> ProcessMetricsSampler::GetHistory(
+    v8::Isolate* isolate) const {
+  const size_t length = history_.size();
+  gin_helper::Dictionary result = gin::Dictionary::CreateEmpty(isolate);
+
+  double* times;
+  result.Set("timestamps", CreateFloat64Array(isolate, length, &times));
+
+  struct Columns {
+    double* cpu_usage;
+    double* idle_wakeups;
+    double* working_set_size;
+    double* handle_count;
+  };
+  std::map<base::ProcessId, Columns> columns;
+  std::vector<gin_helper::Dictionary> processes;
+
+  for (size_t i = 0; i < length; ++i) {
+    const Sample& sample = history_[i];
+    times[i] = sample.time.ToJsTime();
+    for (const Entry& entry : sample.entries) {
+      auto it = columns.find(entry.pid);
+      if (it == columns.end()) {
+        Columns process_columns;
+        gin_helper::Dictionary process = gin::Dictionary::CreateEmpty(isolate);
+        process.Set("pid", entry.pid);
+        process.Set("type", content::GetProcessTypeNameInEnglish(entry.type));
+        process.Set("cpuUsage", CreateFloat64Array(
+                                    isolate, length, &process_columns.cpu_usage));
+        process.Set("idleWakeupsPerSecond",
+                    CreateFloat64Array(isolate, length,
+                                       &process_columns.idle_wakeups));
+        process.Set("workingSetSize",
+                    CreateFloat64Array(isolate, length,
+                                       &process_columns.working_set_size));
+        process.Set("handleCount",
+                    CreateFloat64Array(isolate, length,
+                                       &process_columns.handle_count));
+        processes.push_back(process);
+        it = columns.emplace(entry.pid, process_columns).first;
+      }
+      it->second.cpu_usage[i] = entry.cpu_usage;
+      it->second.idle_wakeups[i] = entry.idle_wakeups;
+      it->second.working_set_size[i] = entry.working_set_size;
+      it->second.handle_count[i] = entry.handle_count;
+    }
+  }
+
+  result.Set("processes", processes);
+  return result.GetHandle();
+}
+
+}  // namespace electron
@@ -0,0 +1,76 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
+#define SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/containers/circular_deque.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/process/process_handle.h"
+#include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+struct ProcessMetric;
+
+// Periodically samples the CPU usage, idle wakeups, memory and handle counts
+// of the processes it is given on a background sequence, and keeps the last
+// |history_size| samples on the UI thread.
+class ProcessMetricsSampler {
+ public:
+  struct Entry {
+    base::ProcessId pid;
+    int type;
+    double cpu_usage;
+    double idle_wakeups;
+    // In kilobytes, like app.getAppMetrics().
+    double working_set_size;
+    double handle_count;
+  };
+
+  struct Sample {
+    Sample();
+    Sample(Sample&&);
+    ~Sample();
+    Sample& operator=(Sample&&);
+
+    base::Time time;
+    std::vector<Entry> entries;
+  };
+
+  ProcessMetricsSampler(base::TimeDelta interval, size_t history_size);
+  ~ProcessMetricsSampler();
+
+  void AddProcess(std::unique_ptr<ProcessMetric> process_metric);
+  void RemoveProcess(base::ProcessId pid);
+
+  // Converts the history into an object holding one Float64Array per metric
+  // and process, so that reading it doesn't allocate an object per sample.
+  v8::Local<v8::Value> GetHistory(v8::Isolate* isolate) const;
+
+ private:
+  class Core;
+
+  void OnSample(Sample sample);
+
+  const size_t history_size_;
+  base::circular_deque<Sample> history_;
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  std::unique_ptr<Core> core_;
+
+  base::WeakPtrFactory<ProcessMetricsSampler> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(ProcessMetricsSampler);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
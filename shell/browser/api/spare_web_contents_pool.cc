@@ -0,0 +1,201 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/spare_web_contents_pool.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/stl_util.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "shell/browser/api/electron_api_web_contents.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/gin_converters/value_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "url/url_constants.h"
+
+namespace electron {
+
+namespace api {
+
+namespace {
+
+// Serializes |web_preferences| into |out|, which fails for preferences that
+// hold objects, like a session.
+bool SerializeWebPreferences(v8::Isolate* isolate,
+                             const gin_helper::Dictionary& web_preferences,
+                             base::Value* out) {
+  if (web_preferences.Has("session"))
+    return false;
+  return gin::ConvertFromV8(isolate, web_preferences.GetHandle(), out) &&
+         out->is_dict();
+}
+
+}  // namespace
+
+SpareWebContentsPool::Profile::Profile() = default;
+SpareWebContentsPool::Profile::~Profile() = default;
+
+// static
+SpareWebContentsPool* SpareWebContentsPool::GetInstance() {
+  static base::NoDestructor<SpareWebContentsPool> instance;
+  return instance.get();
+}
+
+SpareWebContentsPool::SpareWebContentsPool() = default;
+
+SpareWebContentsPool::~SpareWebContentsPool() = default;
+
+bool SpareWebContentsPool::SetSize(
+    v8::Isolate* isolate,
+    const gin_helper::Dictionary& web_preferences,
+    size_t size) {
+  base::Value serialized;
+  if (!SerializeWebPreferences(isolate, web_preferences, &serialized))
+    return false;
+
+  Profile* profile = FindProfile(serialized);
+  if (!profile) {
+    if (size == 0)
+      return true;
+    profiles_.push_back(std::make_unique<Profile>());
+    profile = profiles_.back().get();
+    profile->web_preferences = std::move(serialized);
+  }
+
+  profile->size = size;
+  while (profile->spares.size() > size) {
+    gin::Handle<WebContents> web_contents;
+    if (gin::ConvertFromV8(isolate, profile->spares.back().Get(isolate),
+                           &web_contents))
+      web_contents->DestroyWebContents(true /* async */);
+    profile->spares.pop_back();
+  }
+  if (size == 0) {
+    base::EraseIf(profiles_, [profile](const std::unique_ptr<Profile>& p) {
+      return p.get() == profile;
+    });
+    return true;
+  }
+
+  ScheduleRefill();
+  return true;
+}
+
+gin::Handle<WebContents> SpareWebContentsPool::Take(
+    v8::Isolate* isolate,
+    const gin_helper::Dictionary& web_preferences) {
+  if (profiles_.empty())
+    return gin::Handle<WebContents>();
+
+  base::Value serialized;
+  Profile* profile = nullptr;
+  if (SerializeWebPreferences(isolate, web_preferences, &serialized))
+    profile = FindProfile(serialized);
+  if (!profile) {
+    ++misses_;
+    return gin::Handle<WebContents>();
+  }
+
+  while (!profile->spares.empty()) {
+    v8::Local<v8::Value> value = profile->spares.front().Get(isolate);
+    profile->spares.pop_front();
+
+    gin::Handle<WebContents> web_contents;
+    if (!gin::ConvertFromV8(isolate, value, &web_contents) ||
+        !web_contents->web_contents())
+      continue;
+    // A spare whose renderer went away has nothing left to offer.
+    if (web_contents->IsCrashed()) {
+      web_contents->DestroyWebContents(true /* async */);
+      continue;
+    }
+
+    ++hits_;
+    ScheduleRefill();
+    return web_contents;
+  }
+
+  ++misses_;
+  ScheduleRefill();
+  return gin::Handle<WebContents>();
+}
+
+void SpareWebContentsPool::Clear() {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  for (auto& profile : profiles_) {
+    for (auto& spare : profile->spares) {
+      gin::Handle<WebContents> web_contents;
+      if (gin::ConvertFromV8(isolate, spare.Get(isolate), &web_contents))
+        web_contents->DestroyWebContents(false /* async */);
+    }
+  }
+  profiles_.clear();
+}
+
+SpareWebContentsPool::Stats SpareWebContentsPool::GetStats() const {
+  Stats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  for (const auto& profile : profiles_)
+    stats.count += profile->spares.size();
+  return stats;
+}
+
+SpareWebContentsPool::Profile* SpareWebContentsPool::FindProfile(
+    const base::Value& web_preferences) {
+  for (auto& profile : profiles_) {
+    if (profile->web_preferences == web_preferences)
+      return profile.get();
+  }
+  return nullptr;
+}
+
+void SpareWebContentsPool::ScheduleRefill() {
+  if (refill_scheduled_)
+    return;
+  refill_scheduled_ = true;
+  // The pool is never destroyed.
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&SpareWebContentsPool::Refill,
+                                base::Unretained(this)));
+}
+
+void SpareWebContentsPool::Refill() {
+  refill_scheduled_ = false;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+
+  // Create one spare per profile at a time so that a large pool does not
+  // hold up the tasks that are already waiting.
+  bool needs_more = false;
+  for (auto& profile : profiles_) {
+    if (profile->spares.size() >= profile->size)
+      continue;
+
+    v8::Local<v8::Value> options =
+        gin::ConvertToV8(isolate, profile->web_preferences);
+    gin::Handle<WebContents> web_contents = WebContents::Create(
+        isolate, gin_helper::Dictionary(isolate, options.As<v8::Object>()));
+    // Navigating to about:blank launches the renderer process without
+    // assigning a site to it, so the first real navigation of the window that
+    // adopts it can stay in the same process.
+    web_contents->LoadURL(GURL(url::kAboutBlankURL),
+                          gin::Dictionary::CreateEmpty(isolate));
+    profile->spares.emplace_back(isolate, web_contents.ToV8());
+
+    if (profile->spares.size() < profile->size)
+      needs_more = true;
+  }
+
+  if (needs_more)
+    ScheduleRefill();
+}
+
+}  // namespace api
+
+}  // namespace electron
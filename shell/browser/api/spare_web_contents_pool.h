@@ -0,0 +1,93 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_SPARE_WEB_CONTENTS_POOL_H_
+#define SHELL_BROWSER_API_SPARE_WEB_CONTENTS_POOL_H_
+
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "base/no_destructor.h"
+#include "base/values.h"
+#include "gin/handle.h"
+#include "v8/include/v8.h"
+
+namespace gin_helper {
+class Dictionary;
+}
+
+namespace electron {
+
+namespace api {
+
+class WebContents;
+
+// Keeps hidden webContents that have already launched and initialized their
+// renderer process on about:blank, grouped by the webPreferences they were
+// created with. A BrowserWindow created with exactly the same webPreferences
+// adopts one of them instead of creating its own, and the pool is refilled
+// in the background.
+//
+// Only webPreferences that can be serialized are pooled, so windows given a
+// |session| object always create their own webContents.
+class SpareWebContentsPool {
+ public:
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t count = 0;
+  };
+
+  static SpareWebContentsPool* GetInstance();
+
+  // Keeps |size| spare webContents created with |web_preferences|, a size of
+  // 0 removes the profile. Returns false when |web_preferences| can not be
+  // pooled.
+  bool SetSize(v8::Isolate* isolate,
+               const gin_helper::Dictionary& web_preferences,
+               size_t size);
+
+  // Returns a spare webContents matching |web_preferences|, or an empty handle
+  // when there is none.
+  gin::Handle<WebContents> Take(v8::Isolate* isolate,
+                                const gin_helper::Dictionary& web_preferences);
+
+  // Destroys all the spare webContents and removes all the profiles.
+  void Clear();
+
+  Stats GetStats() const;
+
+ private:
+  friend class base::NoDestructor<SpareWebContentsPool>;
+
+  struct Profile {
+    Profile();
+    ~Profile();
+
+    base::Value web_preferences;
+    size_t size = 0;
+    std::list<v8::Global<v8::Value>> spares;
+  };
+
+  SpareWebContentsPool();
+  ~SpareWebContentsPool();
+
+  Profile* FindProfile(const base::Value& web_preferences);
+  void ScheduleRefill();
+  void Refill();
+
+  std::vector<std::unique_ptr<Profile>> profiles_;
+  bool refill_scheduled_ = false;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(SpareWebContentsPool);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_API_SPARE_WEB_CONTENTS_POOL_H_
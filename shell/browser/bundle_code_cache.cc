@@ -0,0 +1,201 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/bundle_code_cache.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/containers/flat_map.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/path_service.h"
+#include "base/pickle.h"
+#include "base/task/thread_pool.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
+#include "electron/electron_version.h"
+#include "electron/shell/common/api/api.mojom.h"
+#include "gin/converter.h"
+#include "mojo/public/cpp/base/big_buffer.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/electron_paths.h"
+#include "shell/common/node_util.h"
+
+namespace electron {
+
+namespace {
+
+struct Bundle {
+  const char* id;
+  // Null-terminated.
+  const char* parameters[7];
+};
+
+// The bundles and the parameters they are wrapped in, which have to match
+// the CompileAndCall() callers in shell/renderer. renderer_init is loaded by
+// Node as the main script, which wraps it like any other module.
+const Bundle kBundles[] = {
+    {"electron/js2c/renderer_init",
+     {"exports", "require", "module", "process", "internalBinding",
+      "primordials"}},
+    {"electron/js2c/sandbox_bundle", {"binding"}},
+    {"electron/js2c/isolated_bundle", {"nodeProcess", "isolatedWorld"}},
+    {"electron/js2c/content_script_bundle",
+     {"nodeProcess", "isolatedWorld", "worldId"}},
+};
+
+const base::FilePath::CharType kCacheFileName[] =
+    FILE_PATH_LITERAL("BundleCodeCache");
+
+// Reads the caches stored at |path|. They are ignored unless they were made
+// by this version of Electron with the same V8 version and flags.
+base::Optional<BundleCodeCache::Caches> ReadCaches(const base::FilePath& path,
+                                                   uint32_t version_tag) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return base::nullopt;
+
+  base::Pickle pickle(contents.data(), contents.size());
+  base::PickleIterator iter(pickle);
+  std::string version;
+  uint32_t tag;
+  if (!iter.ReadString(&version) || version != ELECTRON_VERSION_STRING ||
+      !iter.ReadUInt32(&tag) || tag != version_tag)
+    return base::nullopt;
+
+  BundleCodeCache::Caches caches;
+  for (const auto& bundle : kBundles) {
+    std::string id;
+    const char* data;
+    int length;
+    if (!iter.ReadString(&id) || id != bundle.id ||
+        !iter.ReadData(&data, &length))
+      return base::nullopt;
+    caches[id].assign(data, data + length);
+  }
+  return caches;
+}
+
+void WriteCaches(const base::FilePath& path,
+                 uint32_t version_tag,
+                 const BundleCodeCache::Caches& caches) {
+  base::Pickle pickle;
+  pickle.WriteString(ELECTRON_VERSION_STRING);
+  pickle.WriteUInt32(version_tag);
+  for (const auto& bundle : kBundles) {
+    const auto& data = caches.at(bundle.id);
+    pickle.WriteString(bundle.id);
+    pickle.WriteData(reinterpret_cast<const char*>(data.data()),
+                     static_cast<int>(data.size()));
+  }
+  base::CreateDirectory(path.DirName());
+  base::ImportantFileWriter::WriteFileAtomically(
+      path, base::StringPiece(static_cast<const char*>(pickle.data()),
+                              pickle.size()));
+}
+
+// Compiles the bundles in a context of their own, so that nothing of them
+// ends up in the app's.
+base::Optional<BundleCodeCache::Caches> ProduceCaches() {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+
+  BundleCodeCache::Caches caches;
+  for (const auto& bundle : kBundles) {
+    std::vector<v8::Local<v8::String>> parameters;
+    for (const char* const* name = bundle.parameters; *name; ++name)
+      parameters.push_back(gin::StringToV8(isolate, *name));
+    std::vector<uint8_t> data =
+        util::CreateCodeCache(context, bundle.id, &parameters);
+    if (data.empty())
+      return base::nullopt;
+    caches[bundle.id] = std::move(data);
+  }
+  return caches;
+}
+
+}  // namespace
+
+// static
+BundleCodeCache* BundleCodeCache::GetInstance() {
+  static base::NoDestructor<BundleCodeCache> instance;
+  return instance.get();
+}
+
+BundleCodeCache::BundleCodeCache()
+    : version_tag_(v8::ScriptCompiler::CachedDataVersionTag()) {}
+
+BundleCodeCache::~BundleCodeCache() = default;
+
+void BundleCodeCache::SendTo(content::RenderProcessHost* host) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (state_ == State::kLoaded) {
+    Send(host);
+    return;
+  }
+
+  pending_process_ids_.push_back(host->GetID());
+  if (state_ == State::kLoading)
+    return;
+
+  // userData can no longer change once renderers are being launched.
+  base::FilePath user_data_dir;
+  if (!base::PathService::Get(DIR_USER_DATA, &user_data_dir)) {
+    OnRead(base::nullopt);
+    return;
+  }
+  path_ = user_data_dir.Append(kCacheFileName);
+  state_ = State::kLoading;
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&ReadCaches, path_, version_tag_),
+      base::BindOnce(&BundleCodeCache::OnRead, base::Unretained(this)));
+}
+
+void BundleCodeCache::OnRead(base::Optional<Caches> caches) {
+  state_ = State::kLoaded;
+  if (!caches) {
+    // First run, or the stored caches are stale: produce them once and store
+    // them for the next launch.
+    caches = ProduceCaches();
+    if (caches && !path_.empty()) {
+      base::ThreadPool::PostTask(
+          FROM_HERE,
+          {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+          base::BindOnce(&WriteCaches, path_, version_tag_, *caches));
+    }
+  }
+  if (caches)
+    caches_ = std::move(*caches);
+
+  for (int process_id : pending_process_ids_) {
+    auto* host = content::RenderProcessHost::FromID(process_id);
+    if (host)
+      Send(host);
+  }
+  pending_process_ids_.clear();
+}
+
+void BundleCodeCache::Send(content::RenderProcessHost* host) {
+  if (caches_.empty())
+    return;
+
+  base::flat_map<std::string, mojo_base::BigBuffer> caches;
+  for (const auto& cache : caches_)
+    caches.emplace(cache.first, mojo_base::BigBuffer(cache.second));
+
+  // Messages sent before the remote goes away are still delivered.
+  mojo::Remote<mojom::ElectronBundleCodeCache> remote;
+  host->BindReceiver(remote.BindNewPipeAndPassReceiver());
+  remote->SetCodeCaches(version_tag_, std::move(caches));
+}
+
+}  // namespace electron
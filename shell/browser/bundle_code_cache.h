@@ -0,0 +1,63 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_BUNDLE_CODE_CACHE_H_
+#define SHELL_BROWSER_BUNDLE_CODE_CACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "base/optional.h"
+
+namespace content {
+class RenderProcessHost;
+}
+
+namespace electron {
+
+// Code caches for the js2c bundles renderers compile in every new context:
+// renderer_init, sandbox_bundle, isolated_bundle and content_script_bundle.
+//
+// The caches are only ever produced here, since caches coming from renderers
+// can't be trusted. They are stored in userData on first run, validated
+// against the Electron version and V8's CachedDataVersionTag when read back,
+// and handed to every renderer process as it launches. Renderers running
+// with other V8 flags than the browser ignore them.
+class BundleCodeCache {
+ public:
+  using Caches = std::map<std::string, std::vector<uint8_t>>;
+
+  static BundleCodeCache* GetInstance();
+
+  // Sends the caches to the renderer of |host|, once they are loaded. The
+  // first call starts loading them.
+  void SendTo(content::RenderProcessHost* host);
+
+ private:
+  friend class base::NoDestructor<BundleCodeCache>;
+
+  enum class State { kNotLoaded, kLoading, kLoaded };
+
+  BundleCodeCache();
+  ~BundleCodeCache();
+
+  void OnRead(base::Optional<Caches> caches);
+  void Send(content::RenderProcessHost* host);
+
+  State state_ = State::kNotLoaded;
+  base::FilePath path_;
+  uint32_t version_tag_;
+  Caches caches_;
+  std::vector<int> pending_process_ids_;
+
+  DISALLOW_COPY_AND_ASSIGN(BundleCodeCache);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_BUNDLE_CODE_CACHE_H_
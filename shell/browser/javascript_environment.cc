@@ -232,6 +232,7 @@ class TracingControllerImpl : public node::tracing::TracingController {
 };
 
 v8::Isolate* JavascriptEnvironment::Initialize(uv_loop_t* event_loop) {
+  TRACE_EVENT0("electron", "JavascriptEnvironment::Initialize");
   auto* cmd = base::CommandLine::ForCurrentProcess();
 
   // --js-flags.
@@ -10,12 +10,15 @@
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "content/public/browser/browser_context.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
 #include "extensions/browser/extension_navigation_ui_data.h"
 #include "mojo/public/cpp/bindings/binding.h"
 #include "net/base/completion_repeating_callback.h"
 #include "net/base/load_flags.h"
 #include "net/http/http_util.h"
 #include "services/network/public/cpp/features.h"
+#include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/net/asar/asar_url_loader.h"
 #include "shell/common/options_switches.h"
 
@@ -296,6 +299,8 @@ void ProxyingURLLoaderFactory::InProgressRequest::OnComplete(
   target_client_->OnComplete(status);
   factory_->web_request_api()->OnCompleted(&info_.value(), request_,
                                            status.error_code);
+  factory_->RecordNetworkUsage(request_.render_frame_id,
+                               status.encoded_data_length);
 
   // Deletes |this|.
   factory_->RemoveRequest(network_service_request_id_, request_id_);
@@ -904,6 +909,18 @@ void ProxyingURLLoaderFactory::OnProxyBindingError() {
   MaybeDeleteThis();
 }
 
+void ProxyingURLLoaderFactory::RecordNetworkUsage(int render_frame_id,
+                                                  int64_t bytes_received) {
+  auto* frame_host =
+      content::RenderFrameHost::FromID(render_process_id_, render_frame_id);
+  if (!frame_host)
+    return;
+  auto* web_contents = api::WebContents::From(
+      content::WebContents::FromRenderFrameHost(frame_host));
+  if (web_contents)
+    web_contents->AddNetworkUsage(bytes_received);
+}
+
 void ProxyingURLLoaderFactory::RemoveRequest(int32_t network_service_request_id,
                                              uint64_t request_id) {
   network_request_id_to_web_request_id_.erase(network_service_request_id);
@@ -221,6 +221,9 @@ class ProxyingURLLoaderFactory
   void RemoveRequest(int32_t network_service_request_id, uint64_t request_id);
   void MaybeDeleteThis();
 
+  // Attributes a completed request to the WebContents owning the frame.
+  void RecordNetworkUsage(int render_frame_id, int64_t bytes_received);
+
   bool ShouldIgnoreConnectionsLimit(const network::ResourceRequest& request);
 
   // Passed from api::WebRequest.
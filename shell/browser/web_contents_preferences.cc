@@ -143,6 +143,7 @@ WebContentsPreferences::WebContentsPreferences(
   SetDefaultBoolIfUndefined(options::kTextAreasAreResizable, true);
   SetDefaultBoolIfUndefined(options::kWebGL, true);
   SetDefaultBoolIfUndefined(options::kEnableWebSQL, true);
+  SetDefaultBoolIfUndefined(options::kReuseNodeIsolateData, false);
   bool webSecurity = true;
   SetDefaultBoolIfUndefined(options::kWebSecurity, webSecurity);
   // If webSecurity was explicity set to false, let's inherit that into
@@ -443,6 +444,9 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   if (IsEnabled(options::kEnableWebSQL))
     command_line->AppendSwitch(switches::kEnableWebSQL);
 
+  if (IsEnabled(options::kReuseNodeIsolateData))
+    command_line->AppendSwitch(switches::kReuseNodeIsolateData);
+
   // We are appending args to a webContents so let's save the current state
   // of our preferences object so that during the lifetime of the WebContents
   // we can fetch the options used to initally configure the WebContents
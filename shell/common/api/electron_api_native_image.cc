@@ -9,25 +9,31 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "gin/arguments.h"
 #include "gin/object_template_builder.h"
 #include "gin/per_isolate_data.h"
 #include "net/base/data_url.h"
 #include "shell/common/asar/asar_util.h"
+#include "shell/common/decoded_image_cache.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gfx_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/function_template_extensions.h"
+#include "shell/common/gin_helper/locker.h"
 #include "shell/common/gin_helper/object_template_builder.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/skia_util.h"
+#include "skia/ext/image_operations.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
@@ -36,6 +42,7 @@
 #include "ui/gfx/codec/jpeg_codec.h"
 #include "ui/gfx/codec/png_codec.h"
 #include "ui/gfx/geometry/size.h"
+#include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/image/image_skia.h"
 #include "ui/gfx/image/image_skia_operations.h"
 #include "ui/gfx/image/image_util.h"
@@ -105,6 +112,151 @@ base::win::ScopedHICON ReadICOFromPath(int size, const base::FilePath& path) {
 
 void Noop(char*, void*) {}
 
+// Reads the optional pixel layout of raw bitmap data from |options|. Keeps
+// the passed defaults for missing keys and returns false on invalid values.
+bool GetPixelFormatFromOptions(const gin_helper::Dictionary& options,
+                               SkColorType* color_type,
+                               SkAlphaType* alpha_type,
+                               std::string* error) {
+  std::string format;
+  if (options.Get("format", &format)) {
+    if (format == "rgba") {
+      *color_type = kRGBA_8888_SkColorType;
+    } else if (format == "bgra") {
+      *color_type = kBGRA_8888_SkColorType;
+    } else {
+      *error = "format must be one of 'rgba' or 'bgra'";
+      return false;
+    }
+  }
+
+  std::string alpha;
+  if (options.Get("alphaType", &alpha)) {
+    if (alpha == "premultiplied") {
+      *alpha_type = kPremul_SkAlphaType;
+    } else if (alpha == "unpremultiplied") {
+      *alpha_type = kUnpremul_SkAlphaType;
+    } else {
+      *error =
+          "alphaType must be one of 'premultiplied' or 'unpremultiplied'";
+      return false;
+    }
+  }
+  return true;
+}
+
+skia::ImageOperations::ResizeMethod GetResizeMethod(
+    const base::DictionaryValue& options) {
+  std::string quality;
+  options.GetString("quality", &quality);
+  if (quality == "good")
+    return skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
+  else if (quality == "better")
+    return skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+  return skia::ImageOperations::ResizeMethod::RESIZE_BEST;
+}
+
+constexpr base::TaskTraits kImageTaskTraits = {
+    base::TaskPriority::USER_VISIBLE,
+    base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN};
+
+void FreeEncodedData(char*, void* hint) {
+  delete static_cast<std::vector<unsigned char>*>(hint);
+}
+
+// Resolves |promise| with a Buffer that takes ownership of |data|.
+void ResolveWithBuffer(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                       std::vector<unsigned char> data) {
+  v8::Isolate* isolate = promise.isolate();
+  gin_helper::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+
+  v8::Local<v8::Object> buffer;
+  if (data.empty()) {
+    buffer = node::Buffer::New(isolate, 0).ToLocalChecked();
+  } else {
+    auto* owned = new std::vector<unsigned char>(std::move(data));
+    buffer = node::Buffer::New(isolate, reinterpret_cast<char*>(owned->data()),
+                               owned->size(), &FreeEncodedData, owned)
+                 .ToLocalChecked();
+  }
+  promise.Resolve(buffer);
+}
+
+// Resolves |promise| with a new NativeImage built from |reps|. The image is
+// assembled on the calling thread since gfx::ImageSkia is bound to the
+// sequence it is created on.
+void ResolveWithImageReps(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                          bool is_template,
+                          std::vector<gfx::ImageSkiaRep> reps) {
+  v8::Isolate* isolate = promise.isolate();
+  gin_helper::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+
+  gfx::ImageSkia image_skia;
+  for (const auto& rep : reps)
+    image_skia.AddRepresentation(rep);
+  gin::Handle<NativeImage> handle =
+      NativeImage::Create(isolate, gfx::Image(image_skia));
+  if (is_template)
+    handle->SetTemplateImage(true);
+  promise.Resolve(handle.ToV8());
+}
+
+std::vector<unsigned char> EncodePNG(const SkBitmap& bitmap) {
+  std::vector<unsigned char> encoded;
+  gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &encoded);
+  return encoded;
+}
+
+std::vector<unsigned char> EncodeJPEG(const SkBitmap& bitmap, int quality) {
+  std::vector<unsigned char> encoded;
+  gfx::JPEGCodec::Encode(bitmap, quality, &encoded);
+  return encoded;
+}
+
+std::vector<gfx::ImageSkiaRep> ResizeBitmap(
+    const SkBitmap& bitmap,
+    skia::ImageOperations::ResizeMethod method,
+    const gfx::Size& size,
+    float scale_factor) {
+  std::vector<gfx::ImageSkiaRep> reps;
+  gfx::Size pixel_size = gfx::ScaleToCeiledSize(size, scale_factor);
+  if (bitmap.drawsNothing() || pixel_size.IsEmpty())
+    return reps;
+  SkBitmap resized = skia::ImageOperations::Resize(
+      bitmap, method, pixel_size.width(), pixel_size.height());
+  reps.emplace_back(resized, scale_factor);
+  return reps;
+}
+
+std::vector<gfx::ImageSkiaRep> DecodeBuffer(std::vector<unsigned char> data,
+                                            int width,
+                                            int height,
+                                            double scale_factor) {
+  gfx::ImageSkia image_skia;
+  electron::util::AddImageSkiaRepFromBuffer(
+      &image_skia, data.data(), data.size(), width, height, scale_factor);
+  return image_skia.image_reps();
+}
+
+std::vector<gfx::ImageSkiaRep> DecodePath(const base::FilePath& path) {
+  gfx::ImageSkia image_skia;
+  // Validating a cached entry stats the files, so it happens here as well.
+  if (DecodedImageCache::GetInstance()->Get(path, &image_skia))
+    return image_skia.image_reps();
+  // Pooled threads never clear the per-thread asar archive cache, which would
+  // keep the archives open for as long as the worker lives. Keep the archive
+  // open only while probing the scale variants instead, parsing its header
+  // once for all of them.
+  std::shared_ptr<asar::Archive> archive;
+  electron::util::PopulateImageSkiaRepsFromPath(&image_skia, path, &archive);
+  DecodedImageCache::GetInstance()->Put(path, image_skia);
+  return image_skia.image_reps();
+}
+
 }  // namespace
 
 NativeImage::NativeImage(v8::Isolate* isolate, const gfx::Image& image)
@@ -179,17 +331,49 @@ v8::Local<v8::Value> NativeImage::ToPNG(gin::Arguments* args) {
 }
 
 v8::Local<v8::Value> NativeImage::ToBitmap(gin::Arguments* args) {
-  float scale_factor = GetScaleFactorFromOptions(args);
+  float scale_factor = 1.0f;
+  SkColorType color_type = kN32_SkColorType;
+  SkAlphaType alpha_type = kPremul_SkAlphaType;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("scaleFactor", &scale_factor);
+    std::string error;
+    if (!GetPixelFormatFromOptions(options, &color_type, &alpha_type,
+                                   &error)) {
+      args->ThrowTypeError(error);
+      return v8::Undefined(args->isolate());
+    }
+  }
 
   const SkBitmap bitmap =
       image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
   SkPixelRef* ref = bitmap.pixelRef();
   if (!ref)
     return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
-  return node::Buffer::Copy(args->isolate(),
-                            reinterpret_cast<const char*>(ref->pixels()),
-                            bitmap.computeByteSize())
-      .ToLocalChecked();
+
+  // Fast path when the requested layout matches the stored pixels.
+  if (color_type == bitmap.colorType() &&
+      (alpha_type == bitmap.alphaType() ||
+       bitmap.alphaType() == kOpaque_SkAlphaType)) {
+    return node::Buffer::Copy(args->isolate(),
+                              reinterpret_cast<const char*>(ref->pixels()),
+                              bitmap.computeByteSize())
+        .ToLocalChecked();
+  }
+
+  // Let Skia do the swizzle and (un)premultiplication, it picks the widest
+  // SIMD implementation (SSSE3/AVX2/NEON) available at runtime and falls back
+  // to portable code otherwise.
+  SkImageInfo info = SkImageInfo::Make(bitmap.width(), bitmap.height(),
+                                       color_type, alpha_type);
+  v8::Local<v8::Object> buffer =
+      node::Buffer::New(args->isolate(), info.computeMinByteSize())
+          .ToLocalChecked();
+  if (!bitmap.readPixels(info, node::Buffer::Data(buffer), info.minRowBytes(),
+                         0, 0)) {
+    return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
+  }
+  return buffer;
 }
 
 v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
@@ -225,6 +409,13 @@ v8::Local<v8::Value> NativeImage::GetBitmap(gin::Arguments* args) {
   SkPixelRef* ref = bitmap.pixelRef();
   if (!ref)
     return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
+  // Immutable pixels may be shared with other images, such as those coming
+  // from the decoded image cache, so writes to the buffer must not reach them.
+  if (bitmap.isImmutable())
+    return node::Buffer::Copy(args->isolate(),
+                              reinterpret_cast<const char*>(ref->pixels()),
+                              bitmap.computeByteSize())
+        .ToLocalChecked();
   return node::Buffer::New(args->isolate(),
                            reinterpret_cast<char*>(ref->pixels()),
                            bitmap.computeByteSize(), &Noop, nullptr)
@@ -272,10 +463,8 @@ float NativeImage::GetAspectRatio(const base::Optional<float> scale_factor) {
     return static_cast<float>(size.width()) / static_cast<float>(size.height());
 }
 
-gin::Handle<NativeImage> NativeImage::Resize(gin::Arguments* args,
-                                             base::DictionaryValue options) {
-  float scale_factor = GetScaleFactorFromOptions(args);
-
+gfx::Size NativeImage::GetResizeSize(float scale_factor,
+                                     const base::DictionaryValue& options) {
   gfx::Size size = GetSize(scale_factor);
   int width = size.width();
   int height = size.height();
@@ -293,22 +482,108 @@ gin::Handle<NativeImage> NativeImage::Resize(gin::Arguments* args,
     size.set_width(height);
     size = gfx::ScaleToRoundedSize(size, GetAspectRatio(scale_factor), 1.f);
   }
+  return size;
+}
 
-  skia::ImageOperations::ResizeMethod method =
-      skia::ImageOperations::ResizeMethod::RESIZE_BEST;
-  std::string quality;
-  options.GetString("quality", &quality);
-  if (quality == "good")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
-  else if (quality == "better")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
-
+gin::Handle<NativeImage> NativeImage::Resize(gin::Arguments* args,
+                                             base::DictionaryValue options) {
+  float scale_factor = GetScaleFactorFromOptions(args);
+  gfx::Size size = GetResizeSize(scale_factor, options);
   gfx::ImageSkia resized = gfx::ImageSkiaOperations::CreateResizedImage(
-      image_.AsImageSkia(), method, size);
+      image_.AsImageSkia(), GetResizeMethod(options), size);
   return gin::CreateHandle(
       args->isolate(), new NativeImage(args->isolate(), gfx::Image(resized)));
 }
 
+SkBitmap NativeImage::CopyBitmap(float scale_factor) {
+  const SkBitmap& bitmap =
+      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  // The pixel ref may be shared with other images, so give the worker its
+  // own pixels instead of marking the shared ones immutable.
+  SkBitmap copy;
+  if (!copy.tryAllocPixels(bitmap.info()) ||
+      !bitmap.readPixels(copy.pixmap()))
+    return SkBitmap();
+  copy.setImmutable();
+  return copy;
+}
+
+v8::Local<v8::Promise> NativeImage::ToPNGAsync(gin::Arguments* args) {
+  float scale_factor = GetScaleFactorFromOptions(args);
+  gin_helper::Promise<v8::Local<v8::Value>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (scale_factor == 1.0f) {
+    // Use raw 1x PNG bytes when available
+    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    if (png->size() > 0) {
+      ResolveWithBuffer(std::move(promise),
+                        std::vector<unsigned char>(
+                            png->front(), png->front() + png->size()));
+      return handle;
+    }
+  }
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&EncodePNG, CopyBitmap(scale_factor)),
+      base::BindOnce(&ResolveWithBuffer, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> NativeImage::ToJPEGAsync(v8::Isolate* isolate,
+                                                int quality) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&EncodeJPEG, CopyBitmap(1.0f), quality),
+      base::BindOnce(&ResolveWithBuffer, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> NativeImage::ToDataURLAsync(gin::Arguments* args) {
+  float scale_factor = GetScaleFactorFromOptions(args);
+  gin_helper::Promise<std::string> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (scale_factor == 1.0f) {
+    // Use raw 1x PNG bytes when available
+    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    if (png->size() > 0) {
+      promise.Resolve(webui::GetPngDataUrl(png->front(), png->size()));
+      return handle;
+    }
+  }
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&webui::GetBitmapDataUrl,
+                     CopyBitmap(scale_factor)),
+      base::BindOnce(
+          [](gin_helper::Promise<std::string> promise, std::string url) {
+            promise.Resolve(url);
+          },
+          std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> NativeImage::ResizeAsync(gin::Arguments* args,
+                                                base::DictionaryValue options) {
+  float scale_factor = GetScaleFactorFromOptions(args);
+  gin_helper::Promise<v8::Local<v8::Value>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  gfx::Size size = GetResizeSize(scale_factor, options);
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&ResizeBitmap, CopyBitmap(scale_factor),
+                     GetResizeMethod(options), size, scale_factor),
+      base::BindOnce(&ResolveWithImageReps, std::move(promise), false));
+  return handle;
+}
+
 gin::Handle<NativeImage> NativeImage::Crop(v8::Isolate* isolate,
                                            const gfx::Rect& rect) {
   gfx::ImageSkia cropped =
@@ -404,7 +679,11 @@ gin::Handle<NativeImage> NativeImage::CreateFromPath(
   }
 #endif
   gfx::ImageSkia image_skia;
-  electron::util::PopulateImageSkiaRepsFromPath(&image_skia, image_path);
+  auto* cache = DecodedImageCache::GetInstance();
+  if (!cache->Get(image_path, &image_skia)) {
+    electron::util::PopulateImageSkiaRepsFromPath(&image_skia, image_path);
+    cache->Put(image_path, image_skia);
+  }
   gfx::Image image(image_skia);
   gin::Handle<NativeImage> handle = Create(isolate, image);
 #if defined(OS_MAC)
@@ -438,7 +717,15 @@ gin::Handle<NativeImage> NativeImage::CreateFromBitmap(
     return gin::Handle<NativeImage>();
   }
 
-  auto info = SkImageInfo::MakeN32(width, height, kPremul_SkAlphaType);
+  SkColorType color_type = kN32_SkColorType;
+  SkAlphaType alpha_type = kPremul_SkAlphaType;
+  std::string error;
+  if (!GetPixelFormatFromOptions(options, &color_type, &alpha_type, &error)) {
+    thrower.ThrowTypeError(error);
+    return gin::Handle<NativeImage>();
+  }
+
+  auto info = SkImageInfo::Make(width, height, color_type, alpha_type);
   auto size_bytes = info.computeMinByteSize();
 
   if (size_bytes != node::Buffer::Length(buffer)) {
@@ -454,7 +741,8 @@ gin::Handle<NativeImage> NativeImage::CreateFromBitmap(
 
   SkBitmap bitmap;
   bitmap.allocN32Pixels(width, height, false);
-  bitmap.writePixels({info, node::Buffer::Data(buffer), bitmap.rowBytes()});
+  // Converts from the source layout to the native N32 premultiplied one.
+  bitmap.writePixels({info, node::Buffer::Data(buffer), info.minRowBytes()});
 
   gfx::ImageSkia image_skia;
   image_skia.AddRepresentation(gfx::ImageSkiaRep(bitmap, scale_factor));
@@ -504,6 +792,72 @@ gin::Handle<NativeImage> NativeImage::CreateFromDataURL(v8::Isolate* isolate,
   return CreateEmpty(isolate);
 }
 
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromPathAsync(
+    v8::Isolate* isolate,
+    const base::FilePath& path) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  base::FilePath image_path = NormalizePath(path);
+#if defined(OS_WIN)
+  // ICO files are loaded lazily per size through the HICON cache.
+  if (image_path.MatchesExtension(FILE_PATH_LITERAL(".ico"))) {
+    promise.Resolve(CreateFromPath(isolate, image_path).ToV8());
+    return handle;
+  }
+#endif
+#if defined(OS_MAC)
+  bool is_template = IsTemplateFilename(image_path);
+#else
+  bool is_template = false;
+#endif
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&DecodePath, image_path),
+      base::BindOnce(&ResolveWithImageReps, std::move(promise), is_template));
+  return handle;
+}
+
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromBufferAsync(
+    gin_helper::ErrorThrower thrower,
+    v8::Local<v8::Value> buffer,
+    gin::Arguments* args) {
+  if (!node::Buffer::HasInstance(buffer)) {
+    thrower.ThrowError("buffer must be a node Buffer");
+    return v8::Local<v8::Promise>();
+  }
+
+  int width = 0;
+  int height = 0;
+  double scale_factor = 1.;
+
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("width", &width);
+    options.Get("height", &height);
+    options.Get("scaleFactor", &scale_factor);
+  }
+
+  gin_helper::Promise<v8::Local<v8::Value>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // The buffer may be modified by JS once we return, so decode from a copy.
+  const auto* data =
+      reinterpret_cast<unsigned char*>(node::Buffer::Data(buffer));
+  std::vector<unsigned char> copy(data, data + node::Buffer::Length(buffer));
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&DecodeBuffer, std::move(copy), width, height,
+                     scale_factor),
+      base::BindOnce(&ResolveWithImageReps, std::move(promise), false));
+  return handle;
+}
+
 #if !defined(OS_MAC)
 gin::Handle<NativeImage> NativeImage::CreateFromNamedImage(gin::Arguments* args,
                                                            std::string name) {
@@ -539,6 +893,10 @@ gin::ObjectTemplateBuilder NativeImage::GetObjectTemplateBuilder(
       .SetProperty("isMacTemplateImage", &NativeImage::IsTemplateImage,
                    &NativeImage::SetTemplateImage)
       .SetMethod("resize", &NativeImage::Resize)
+      .SetMethod("toPNGAsync", &NativeImage::ToPNGAsync)
+      .SetMethod("toJPEGAsync", &NativeImage::ToJPEGAsync)
+      .SetMethod("toDataURLAsync", &NativeImage::ToDataURLAsync)
+      .SetMethod("resizeAsync", &NativeImage::ResizeAsync)
       .SetMethod("crop", &NativeImage::Crop)
       .SetMethod("getAspectRatio", &NativeImage::GetAspectRatio)
       .SetMethod("addRepresentation", &NativeImage::AddRepresentation);
@@ -601,8 +959,32 @@ bool Converter<electron::api::NativeImage*>::FromV8(
 
 namespace {
 
+using electron::DecodedImageCache;
 using electron::api::NativeImage;
 
+gin_helper::Dictionary GetCacheStats(v8::Isolate* isolate) {
+  DecodedImageCache::Stats stats = DecodedImageCache::GetInstance()->GetStats();
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("hits", static_cast<double>(stats.hits));
+  dict.Set("misses", static_cast<double>(stats.misses));
+  dict.Set("count", static_cast<double>(stats.count));
+  dict.Set("size", static_cast<double>(stats.size));
+  dict.Set("maxSize", static_cast<double>(stats.max_size));
+  return dict;
+}
+
+void PurgeCache() {
+  DecodedImageCache::GetInstance()->Purge();
+}
+
+void SetCacheLimit(gin_helper::ErrorThrower thrower, double max_size) {
+  if (max_size < 0) {
+    thrower.ThrowError("Cache limit must not be negative");
+    return;
+  }
+  DecodedImageCache::GetInstance()->SetMaxSize(static_cast<size_t>(max_size));
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -617,6 +999,13 @@ void Initialize(v8::Local<v8::Object> exports,
   native_image.SetMethod("createFromBitmap", &NativeImage::CreateFromBitmap);
   native_image.SetMethod("createFromBuffer", &NativeImage::CreateFromBuffer);
   native_image.SetMethod("createFromDataURL", &NativeImage::CreateFromDataURL);
+  native_image.SetMethod("createFromPathAsync",
+                         &NativeImage::CreateFromPathAsync);
+  native_image.SetMethod("createFromBufferAsync",
+                         &NativeImage::CreateFromBufferAsync);
+  native_image.SetMethod("getCacheStats", &GetCacheStats);
+  native_image.SetMethod("purgeCache", &PurgeCache);
+  native_image.SetMethod("setCacheLimit", &SetCacheLimit);
   native_image.SetMethod("createFromNamedImage",
                          &NativeImage::CreateFromNamedImage);
 #if !defined(OS_LINUX)
@@ -13,6 +13,7 @@
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "shell/common/gin_helper/error_thrower.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "ui/gfx/image/image.h"
 
 #if defined(OS_WIN)
@@ -66,6 +67,13 @@ class NativeImage : public gin::Wrappable<NativeImage> {
       gin::Arguments* args);
   static gin::Handle<NativeImage> CreateFromDataURL(v8::Isolate* isolate,
                                                     const GURL& url);
+  static v8::Local<v8::Promise> CreateFromPathAsync(
+      v8::Isolate* isolate,
+      const base::FilePath& path);
+  static v8::Local<v8::Promise> CreateFromBufferAsync(
+      gin_helper::ErrorThrower thrower,
+      v8::Local<v8::Value> buffer,
+      gin::Arguments* args);
   static gin::Handle<NativeImage> CreateFromNamedImage(gin::Arguments* args,
                                                        std::string name);
 #if !defined(OS_LINUX)
@@ -89,6 +97,11 @@ class NativeImage : public gin::Wrappable<NativeImage> {
 
   const gfx::Image& image() const { return image_; }
 
+  // Mark the image as template image.
+  void SetTemplateImage(bool setAsTemplate);
+  // Determine if the image is a template image.
+  bool IsTemplateImage();
+
  protected:
   NativeImage(v8::Isolate* isolate, const gfx::Image& image);
 #if defined(OS_WIN)
@@ -105,17 +118,25 @@ class NativeImage : public gin::Wrappable<NativeImage> {
   v8::Local<v8::Value> GetNativeHandle(gin_helper::ErrorThrower thrower);
   gin::Handle<NativeImage> Resize(gin::Arguments* args,
                                   base::DictionaryValue options);
+  // The async variants hand an immutable copy of the bitmap over to the
+  // thread pool and resolve the returned promise on the calling thread.
+  v8::Local<v8::Promise> ToPNGAsync(gin::Arguments* args);
+  v8::Local<v8::Promise> ToJPEGAsync(v8::Isolate* isolate, int quality);
+  v8::Local<v8::Promise> ToDataURLAsync(gin::Arguments* args);
+  v8::Local<v8::Promise> ResizeAsync(gin::Arguments* args,
+                                     base::DictionaryValue options);
   gin::Handle<NativeImage> Crop(v8::Isolate* isolate, const gfx::Rect& rect);
   std::string ToDataURL(gin::Arguments* args);
   bool IsEmpty();
   gfx::Size GetSize(const base::Optional<float> scale_factor);
   float GetAspectRatio(const base::Optional<float> scale_factor);
   void AddRepresentation(const gin_helper::Dictionary& options);
-
-  // Mark the image as template image.
-  void SetTemplateImage(bool setAsTemplate);
-  // Determine if the image is a template image.
-  bool IsTemplateImage();
+  // Returns the target size of a resize with |options|.
+  gfx::Size GetResizeSize(float scale_factor,
+                          const base::DictionaryValue& options);
+  // Returns a copy of the representation matching |scale_factor| with its own
+  // pixels, which can be safely read from other threads.
+  SkBitmap CopyBitmap(float scale_factor);
 
 #if defined(OS_WIN)
   base::FilePath hicon_path_;
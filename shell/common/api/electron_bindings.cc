@@ -331,13 +331,21 @@ v8::Local<v8::Value> ElectronBindings::GetIOCounters(v8::Isolate* isolate) {
 
 // static
 bool ElectronBindings::TakeHeapSnapshot(v8::Isolate* isolate,
-                                        const base::FilePath& file_path) {
+                                        const base::FilePath& file_path,
+                                        gin_helper::Arguments* args) {
+  // No progress callback here: it would run while V8 is walking this very
+  // isolate's heap, where calling into JS is not allowed.
+  HeapSnapshotOptions options;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict))
+    dict.Get("compress", &options.compress);
+
   base::ThreadRestrictions::ScopedAllowIO allow_io;
 
   base::File file(file_path,
                   base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
 
-  return electron::TakeHeapSnapshot(isolate, &file);
+  return electron::TakeHeapSnapshot(isolate, &file, options);
 }
 
 }  // namespace electron
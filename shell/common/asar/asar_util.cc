@@ -11,6 +11,7 @@
 #include "base/files/file_util.h"
 #include "base/lazy_instance.h"
 #include "base/stl_util.h"
+#include "base/synchronization/lock.h"
 #include "base/threading/thread_local.h"
 #include "base/threading/thread_restrictions.h"
 #include "shell/common/asar/archive.h"
@@ -26,15 +27,30 @@ base::LazyInstance<base::ThreadLocalPointer<ArchiveMap>>::Leaky
 
 const base::FilePath::CharType kAsarExtension[] = FILE_PATH_LITERAL(".asar");
 
+// Archive paths can be resolved from the thread pool, e.g. when loading
+// images asynchronously, so guard the cache with a lock.
+base::LazyInstance<base::Lock>::Leaky g_is_directory_cache_lock =
+    LAZY_INSTANCE_INITIALIZER;
 std::map<base::FilePath, bool> g_is_directory_cache;
 
 bool IsDirectoryCached(const base::FilePath& path) {
-  auto it = g_is_directory_cache.find(path);
-  if (it != g_is_directory_cache.end()) {
-    return it->second;
+  {
+    base::AutoLock auto_lock(g_is_directory_cache_lock.Get());
+    auto it = g_is_directory_cache.find(path);
+    if (it != g_is_directory_cache.end()) {
+      return it->second;
+    }
   }
-  base::ThreadRestrictions::ScopedAllowIO allow_io;
-  return g_is_directory_cache[path] = base::DirectoryExists(path);
+
+  // Don't block other threads on the disk, racing lookups just check twice.
+  bool is_directory;
+  {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    is_directory = base::DirectoryExists(path);
+  }
+  base::AutoLock auto_lock(g_is_directory_cache_lock.Get());
+  g_is_directory_cache.emplace(path, is_directory);
+  return is_directory;
 }
 
 }  // namespace
@@ -89,12 +105,23 @@ bool GetAsarArchivePath(const base::FilePath& full_path,
   return true;
 }
 
-bool ReadFileToString(const base::FilePath& path, std::string* contents) {
+bool ReadFileToString(const base::FilePath& path,
+                      std::string* contents,
+                      std::shared_ptr<Archive>* archive_holder) {
   base::FilePath asar_path, relative_path;
   if (!GetAsarArchivePath(path, &asar_path, &relative_path))
     return base::ReadFileToString(path, contents);
 
-  std::shared_ptr<Archive> archive = GetOrCreateAsarArchive(asar_path);
+  std::shared_ptr<Archive> archive;
+  if (!archive_holder) {
+    archive = GetOrCreateAsarArchive(asar_path);
+  } else {
+    if (!*archive_holder || (*archive_holder)->path() != asar_path) {
+      archive = std::make_shared<Archive>(asar_path);
+      *archive_holder = archive->Init() ? archive : nullptr;
+    }
+    archive = *archive_holder;
+  }
   if (!archive)
     return false;
 
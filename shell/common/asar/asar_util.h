@@ -28,8 +28,14 @@ bool GetAsarArchivePath(const base::FilePath& full_path,
                         base::FilePath* relative_path,
                         bool allow_root = false);
 
-// Same with base::ReadFileToString but supports asar Archive.
-bool ReadFileToString(const base::FilePath& path, std::string* contents);
+// Same with base::ReadFileToString but supports asar Archive. Threads that
+// never call ClearArchives(), like those of the thread pool, should pass
+// |archive| so the archive is kept there instead of in the thread's cache,
+// and only stays open for as long as they hold on to it. It is reused by
+// later reads from the same archive.
+bool ReadFileToString(const base::FilePath& path,
+                      std::string* contents,
+                      std::shared_ptr<Archive>* archive = nullptr);
 
 }  // namespace asar
 
@@ -0,0 +1,175 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/decoded_image_cache.h"
+
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/threading/thread_restrictions.h"
+#include "shell/common/asar/asar_util.h"
+#include "shell/common/skia_util.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace electron {
+
+namespace {
+
+// The cache is opt-in, since keeping decoded pixels alive only pays off for
+// apps loading the same images repeatedly.
+const size_t kDefaultMaxSize = 0;
+
+// Returns the stamp of the file backing |path|, which is the archive for
+// files inside asar, or a null stamp when it does not exist.
+DecodedImageCache::FileStamp GetFileStamp(const base::FilePath& path) {
+  base::FilePath file_path = path;
+  base::FilePath asar_path, relative_path;
+  if (asar::GetAsarArchivePath(path, &asar_path, &relative_path))
+    file_path = asar_path;
+
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  base::File::Info info;
+  if (!base::GetFileInfo(file_path, &info))
+    return DecodedImageCache::FileStamp();
+  // The modification time alone misses writes within its granularity and
+  // files replaced with older copies, so also compare the size and the
+  // creation time, which is the status change time on POSIX.
+  return {info.last_modified, info.creation_time, info.size};
+}
+
+}  // namespace
+
+DecodedImageCache::Entry::Entry() = default;
+DecodedImageCache::Entry::Entry(Entry&&) = default;
+DecodedImageCache::Entry& DecodedImageCache::Entry::operator=(Entry&&) =
+    default;
+DecodedImageCache::Entry::~Entry() = default;
+
+// static
+DecodedImageCache* DecodedImageCache::GetInstance() {
+  static base::NoDestructor<DecodedImageCache> instance;
+  return instance.get();
+}
+
+DecodedImageCache::DecodedImageCache()
+    : entries_(base::MRUCache<base::FilePath, Entry>::NO_AUTO_EVICT),
+      max_size_(kDefaultMaxSize) {}
+
+DecodedImageCache::~DecodedImageCache() = default;
+
+bool DecodedImageCache::Get(const base::FilePath& path,
+                            gfx::ImageSkia* image) {
+  FileStamps sources;
+  {
+    base::AutoLock auto_lock(lock_);
+    // Lookups while the cache is disabled are not misses it could avoid.
+    if (max_size_ == 0)
+      return false;
+    auto it = entries_.Peek(path);
+    if (it == entries_.end()) {
+      ++misses_;
+      return false;
+    }
+    sources = it->second.sources;
+  }
+
+  // Stat the files without holding the lock.
+  for (auto& source : sources)
+    source.second = GetFileStamp(source.first);
+
+  base::AutoLock auto_lock(lock_);
+  auto it = entries_.Get(path);
+  if (it == entries_.end()) {
+    ++misses_;
+    return false;
+  }
+  if (it->second.sources != sources) {
+    size_ -= it->second.size;
+    entries_.Erase(it);
+    ++misses_;
+    return false;
+  }
+
+  ++hits_;
+  // Build a new image around the shared pixels so that adding
+  // representations to it does not leak back into the cache.
+  gfx::ImageSkia result;
+  for (const auto& rep : it->second.reps)
+    result.AddRepresentation(rep);
+  *image = result;
+  return true;
+}
+
+void DecodedImageCache::Put(const base::FilePath& path,
+                            const gfx::ImageSkia& image) {
+  if (image.isNull())
+    return;
+
+  {
+    base::AutoLock auto_lock(lock_);
+    if (max_size_ == 0)
+      return;
+  }
+
+  Entry entry;
+  entry.reps = image.image_reps();
+  for (const auto& rep : entry.reps) {
+    // The pixels are shared with every image handed out for |path|, so
+    // nobody may write to them in place anymore.
+    SkBitmap bitmap = rep.GetBitmap();
+    bitmap.setImmutable();
+    entry.size += bitmap.computeByteSize();
+  }
+  for (const auto& source : util::GetImageSkiaRepPathsFromPath(path)) {
+    FileStamp stamp = GetFileStamp(source);
+    if (!stamp.last_modified.is_null())
+      entry.sources.emplace_back(source, stamp);
+  }
+
+  base::AutoLock auto_lock(lock_);
+  if (entry.size > max_size_)
+    return;
+  auto it = entries_.Peek(path);
+  if (it != entries_.end()) {
+    size_ -= it->second.size;
+    entries_.Erase(it);
+  }
+  size_ += entry.size;
+  entries_.Put(path, std::move(entry));
+  EvictIfNeeded();
+}
+
+void DecodedImageCache::Purge() {
+  base::AutoLock auto_lock(lock_);
+  entries_.Clear();
+  size_ = 0;
+}
+
+void DecodedImageCache::SetMaxSize(size_t max_size) {
+  base::AutoLock auto_lock(lock_);
+  max_size_ = max_size;
+  EvictIfNeeded();
+}
+
+DecodedImageCache::Stats DecodedImageCache::GetStats() {
+  base::AutoLock auto_lock(lock_);
+  Stats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.count = entries_.size();
+  stats.size = size_;
+  stats.max_size = max_size_;
+  return stats;
+}
+
+void DecodedImageCache::EvictIfNeeded() {
+  lock_.AssertAcquired();
+  while (size_ > max_size_ && !entries_.empty()) {
+    auto oldest = entries_.rbegin();
+    size_ -= oldest->second.size;
+    entries_.Erase(oldest);
+  }
+}
+
+}  // namespace electron
@@ -0,0 +1,100 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_DECODED_IMAGE_CACHE_H_
+#define SHELL_COMMON_DECODED_IMAGE_CACHE_H_
+
+#include <utility>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "ui/gfx/image/image_skia.h"
+
+namespace electron {
+
+// A process-wide, size-bounded LRU cache of images decoded from files by
+// nativeImage.createFromPath(), which is also what Tray, Menu and
+// BrowserWindow icons given as paths go through.
+//
+// Entries are validated against the modification time, creation time and
+// size of every file the image was decoded from (the archive itself for files
+// inside asar), so edits on disk are picked up on the next lookup. Scale
+// variants added next to an already cached file are only noticed after the
+// entry is purged. The cache is disabled until SetMaxSize() is called.
+class DecodedImageCache {
+ public:
+  struct FileStamp {
+    base::Time last_modified;
+    base::Time creation_time;
+    int64_t size = 0;
+
+    bool operator==(const FileStamp& other) const {
+      return last_modified == other.last_modified &&
+             creation_time == other.creation_time && size == other.size;
+    }
+    bool operator!=(const FileStamp& other) const { return !(*this == other); }
+  };
+
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t count = 0;
+    size_t size = 0;
+    size_t max_size = 0;
+  };
+
+  static DecodedImageCache* GetInstance();
+
+  // Returns true and sets |image| to a fresh image sharing the cached pixels
+  // when a valid entry exists for |path|.
+  bool Get(const base::FilePath& path, gfx::ImageSkia* image);
+
+  // Stores the representations of |image|, which was just decoded from
+  // |path|, and marks their pixels immutable since they are shared from now
+  // on. Empty images are not cached.
+  void Put(const base::FilePath& path, const gfx::ImageSkia& image);
+
+  void Purge();
+  void SetMaxSize(size_t max_size);
+  Stats GetStats();
+
+ private:
+  friend class base::NoDestructor<DecodedImageCache>;
+
+  using FileStamps = std::vector<std::pair<base::FilePath, FileStamp>>;
+
+  struct Entry {
+    Entry();
+    Entry(Entry&&);
+    Entry& operator=(Entry&&);
+    ~Entry();
+
+    std::vector<gfx::ImageSkiaRep> reps;
+    FileStamps sources;
+    size_t size = 0;
+  };
+
+  DecodedImageCache();
+  ~DecodedImageCache();
+
+  // Must be called with |lock_| held.
+  void EvictIfNeeded();
+
+  base::Lock lock_;
+  base::MRUCache<base::FilePath, Entry> entries_;
+  size_t size_ = 0;
+  size_t max_size_;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(DecodedImageCache);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_DECODED_IMAGE_CACHE_H_
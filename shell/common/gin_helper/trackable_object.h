@@ -102,6 +102,15 @@ class TrackableObject : public TrackableObjectBase, public EventEmitter<T> {
       return std::vector<v8::Local<v8::Object>>();
   }
 
+  // Returns the next object in this class's weak map, see KeyWeakMap::Next.
+  static v8::MaybeLocal<v8::Object> GetNext(v8::Isolate* isolate,
+                                            size_t* cursor) {
+    if (weak_map_)
+      return weak_map_->Next(isolate, cursor);
+    else
+      return v8::MaybeLocal<v8::Object>();
+  }
+
   // Removes this instance from the weak map.
   void RemoveFromWeakMap() {
     if (weak_map_ && weak_map_->Has(weak_map_id()))
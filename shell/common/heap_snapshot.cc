@@ -4,53 +4,148 @@
 
 #include "shell/common/heap_snapshot.h"
 
+#include <memory>
+
+#include "base/bind.h"
+#include "third_party/zlib/zlib.h"
 #include "v8/include/v8-profiler.h"
 
 namespace {
 
+constexpr int kChunkSize = 65536;
+
 class HeapSnapshotOutputStream : public v8::OutputStream {
  public:
-  explicit HeapSnapshotOutputStream(base::File* file) : file_(file) {
-    DCHECK(file_);
+  HeapSnapshotOutputStream(const electron::HeapSnapshotDataCallback& on_data,
+                           bool compress)
+      : on_data_(on_data), compress_(compress) {
+    if (compress_) {
+      // Snapshots run to gigabytes, so favor speed over ratio. The extra 16
+      // in the window bits asks for a gzip header instead of a zlib one.
+      if (deflateInit2(&zstream_, Z_BEST_SPEED, Z_DEFLATED, MAX_WBITS + 16,
+                       8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        failed_ = true;
+      }
+    }
+  }
+
+  ~HeapSnapshotOutputStream() override {
+    if (compress_)
+      deflateEnd(&zstream_);
   }
 
-  bool IsComplete() const { return is_complete_; }
+  bool IsComplete() const { return is_complete_ && !failed_; }
 
   // v8::OutputStream
-  int GetChunkSize() override { return 65536; }
-  void EndOfStream() override { is_complete_ = true; }
+  int GetChunkSize() override { return kChunkSize; }
+
+  void EndOfStream() override {
+    if (compress_ && !failed_)
+      failed_ = !Deflate(nullptr, 0, Z_FINISH);
+    is_complete_ = true;
+  }
 
   v8::OutputStream::WriteResult WriteAsciiChunk(char* data, int size) override {
-    auto bytes_written = file_->WriteAtCurrentPos(data, size);
-    return bytes_written == size ? kContinue : kAbort;
+    if (failed_)
+      return kAbort;
+    if (compress_)
+      failed_ = !Deflate(data, size, Z_NO_FLUSH);
+    else
+      failed_ = !on_data_.Run(base::make_span(
+          reinterpret_cast<const uint8_t*>(data), static_cast<size_t>(size)));
+    return failed_ ? kAbort : kContinue;
   }
 
  private:
-  base::File* file_ = nullptr;
+  bool Deflate(char* data, int size, int flush) {
+    zstream_.next_in = reinterpret_cast<Bytef*>(data);
+    zstream_.avail_in = size;
+    int result;
+    do {
+      zstream_.next_out = buffer_;
+      zstream_.avail_out = sizeof(buffer_);
+      result = deflate(&zstream_, flush);
+      if (result == Z_STREAM_ERROR)
+        return false;
+      size_t length = sizeof(buffer_) - zstream_.avail_out;
+      if (length > 0 && !on_data_.Run(base::make_span(buffer_, length)))
+        return false;
+    } while (zstream_.avail_out == 0);
+    return flush != Z_FINISH || result == Z_STREAM_END;
+  }
+
+  electron::HeapSnapshotDataCallback on_data_;
+  const bool compress_;
+  z_stream zstream_ = {};
+  uint8_t buffer_[kChunkSize];
   bool is_complete_ = false;
+  bool failed_ = false;
 };
 
+class HeapSnapshotActivityControl : public v8::ActivityControl {
+ public:
+  explicit HeapSnapshotActivityControl(
+      const electron::HeapSnapshotProgressCallback& progress)
+      : progress_(progress) {}
+
+  // v8::ActivityControl
+  ControlOption ReportProgressValue(int done, int total) override {
+    progress_.Run(done, total);
+    return kContinue;
+  }
+
+ private:
+  electron::HeapSnapshotProgressCallback progress_;
+};
+
+bool WriteToFile(base::File* file, base::span<const uint8_t> data) {
+  auto bytes_written = file->WriteAtCurrentPos(
+      reinterpret_cast<const char*>(data.data()), data.size());
+  return bytes_written == static_cast<int>(data.size());
+}
+
 }  // namespace
 
 namespace electron {
 
-bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
-  DCHECK(isolate);
+HeapSnapshotOptions::HeapSnapshotOptions() = default;
+HeapSnapshotOptions::HeapSnapshotOptions(const HeapSnapshotOptions&) = default;
+HeapSnapshotOptions::~HeapSnapshotOptions() = default;
+
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      base::File* file,
+                      const HeapSnapshotOptions& options) {
   DCHECK(file);
 
   if (!file->IsValid())
     return false;
 
-  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
+  return TakeHeapSnapshot(
+      isolate, base::BindRepeating(&WriteToFile, base::Unretained(file)),
+      options);
+}
+
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      const HeapSnapshotDataCallback& on_data,
+                      const HeapSnapshotOptions& options) {
+  DCHECK(isolate);
+
+  std::unique_ptr<HeapSnapshotActivityControl> control;
+  if (options.progress)
+    control = std::make_unique<HeapSnapshotActivityControl>(options.progress);
+
+  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot(control.get());
   if (!snapshot)
     return false;
 
-  HeapSnapshotOutputStream stream(file);
-  snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+  // The stream holds its own output buffer, so keep it off the stack.
+  auto stream =
+      std::make_unique<HeapSnapshotOutputStream>(on_data, options.compress);
+  snapshot->Serialize(stream.get(), v8::HeapSnapshot::kJSON);
 
   const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
 
-  return stream.IsComplete();
+  return stream->IsComplete();
 }
 
 }  // namespace electron
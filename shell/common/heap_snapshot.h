@@ -5,12 +5,39 @@
 #ifndef SHELL_COMMON_HEAP_SNAPSHOT_H_
 #define SHELL_COMMON_HEAP_SNAPSHOT_H_
 
+#include "base/callback.h"
+#include "base/containers/span.h"
 #include "base/files/file.h"
 #include "v8/include/v8.h"
 
 namespace electron {
 
-bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file);
+// Receives the serialized snapshot in order; returning false aborts it.
+using HeapSnapshotDataCallback =
+    base::RepeatingCallback<bool(base::span<const uint8_t> data)>;
+
+// Reports how far V8 got building the snapshot. It runs while the heap is
+// being walked, so it must not call back into the isolate.
+using HeapSnapshotProgressCallback =
+    base::RepeatingCallback<void(int done, int total)>;
+
+struct HeapSnapshotOptions {
+  HeapSnapshotOptions();
+  HeapSnapshotOptions(const HeapSnapshotOptions&);
+  ~HeapSnapshotOptions();
+
+  // Whether to gzip the snapshot as it is serialized.
+  bool compress = false;
+  HeapSnapshotProgressCallback progress;
+};
+
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      base::File* file,
+                      const HeapSnapshotOptions& options = {});
+
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      const HeapSnapshotDataCallback& on_data,
+                      const HeapSnapshotOptions& options);
 
 }  // namespace electron
 
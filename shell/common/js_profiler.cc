@@ -0,0 +1,261 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/js_profiler.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/json/json_common.h"
+#include "base/json/json_writer.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+#include "gin/arguments.h"
+#include "gin/converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "v8/include/v8-profiler.h"
+
+namespace electron {
+
+namespace {
+
+const char kProfileTitle[] = "electron";
+
+// The heap profile nests a node and its children list per frame, below the
+// result object and the root node, and the deepest node holds a callFrame.
+static_assert(2 + 2 * JsProfiler::kMaxHeapStackDepth + 2 <=
+                  base::internal::kAbsoluteMaxDepth,
+              "heap profiles of the maximum stack depth must serialize");
+
+base::Optional<std::string> WriteJSON(const base::Value& value) {
+  std::string json;
+  if (!base::JSONWriter::Write(value, &json))
+    return base::nullopt;
+  return json;
+}
+
+// V8 numbers lines and columns from 1, with 0 meaning unknown, while the
+// DevTools formats number them from 0, with -1 meaning unknown.
+base::Value CreateCallFrame(const std::string& function_name,
+                            int script_id,
+                            const std::string& url,
+                            int line_number,
+                            int column_number) {
+  base::Value call_frame(base::Value::Type::DICTIONARY);
+  call_frame.SetStringKey("functionName", function_name);
+  call_frame.SetStringKey("scriptId", base::NumberToString(script_id));
+  call_frame.SetStringKey("url", url);
+  call_frame.SetIntKey("lineNumber", line_number - 1);
+  call_frame.SetIntKey("columnNumber", column_number - 1);
+  return call_frame;
+}
+
+base::Optional<std::string> SerializeCpuProfile(
+    const v8::CpuProfile* profile) {
+  // The tree is as deep as the deepest JS stack, so walk it without
+  // recursing.
+  base::Value nodes(base::Value::Type::LIST);
+  std::vector<const v8::CpuProfileNode*> pending = {profile->GetTopDownRoot()};
+  while (!pending.empty()) {
+    const v8::CpuProfileNode* node = pending.back();
+    pending.pop_back();
+
+    base::Value children(base::Value::Type::LIST);
+    for (int i = 0; i < node->GetChildrenCount(); ++i) {
+      const v8::CpuProfileNode* child = node->GetChild(i);
+      children.Append(static_cast<int>(child->GetNodeId()));
+      pending.push_back(child);
+    }
+
+    base::Value entry(base::Value::Type::DICTIONARY);
+    entry.SetIntKey("id", node->GetNodeId());
+    entry.SetKey("callFrame",
+                 CreateCallFrame(node->GetFunctionNameStr(),
+                                 node->GetScriptId(),
+                                 node->GetScriptResourceNameStr(),
+                                 node->GetLineNumber(),
+                                 node->GetColumnNumber()));
+    entry.SetIntKey("hitCount", node->GetHitCount());
+    entry.SetKey("children", std::move(children));
+    nodes.Append(std::move(entry));
+  }
+
+  // Timestamps are stored as deltas, which keeps the samples compact.
+  base::Value samples(base::Value::Type::LIST);
+  base::Value time_deltas(base::Value::Type::LIST);
+  int64_t last_time = profile->GetStartTime();
+  for (int i = 0; i < profile->GetSamplesCount(); ++i) {
+    samples.Append(static_cast<int>(profile->GetSample(i)->GetNodeId()));
+    int64_t time = profile->GetSampleTimestamp(i);
+    time_deltas.Append(static_cast<double>(time - last_time));
+    last_time = time;
+  }
+
+  base::Value result(base::Value::Type::DICTIONARY);
+  result.SetKey("nodes", std::move(nodes));
+  result.SetDoubleKey("startTime",
+                      static_cast<double>(profile->GetStartTime()));
+  result.SetDoubleKey("endTime", static_cast<double>(profile->GetEndTime()));
+  result.SetKey("samples", std::move(samples));
+  result.SetKey("timeDeltas", std::move(time_deltas));
+
+  return WriteJSON(result);
+}
+
+std::string ToStdString(v8::Isolate* isolate, v8::Local<v8::String> value) {
+  return value.IsEmpty() ? std::string() : gin::V8ToString(isolate, value);
+}
+
+// The tree is at most as deep as the stack depth given to the profiler.
+base::Value SerializeHeapProfileNode(v8::Isolate* isolate,
+                                     const v8::AllocationProfile::Node* node) {
+  double self_size = 0;
+  for (const auto& allocation : node->allocations)
+    self_size += static_cast<double>(allocation.size) * allocation.count;
+
+  base::Value children(base::Value::Type::LIST);
+  for (const auto* child : node->children)
+    children.Append(SerializeHeapProfileNode(isolate, child));
+
+  base::Value entry(base::Value::Type::DICTIONARY);
+  entry.SetKey("callFrame",
+               CreateCallFrame(ToStdString(isolate, node->name),
+                               node->script_id,
+                               ToStdString(isolate, node->script_name),
+                               node->line_number, node->column_number));
+  entry.SetDoubleKey("selfSize", self_size);
+  entry.SetIntKey("id", node->node_id);
+  entry.SetKey("children", std::move(children));
+  return entry;
+}
+
+base::Optional<std::string> SerializeHeapProfile(
+    v8::Isolate* isolate,
+    v8::AllocationProfile* profile) {
+  base::Value samples(base::Value::Type::LIST);
+  for (const auto& sample : profile->GetSamples()) {
+    base::Value entry(base::Value::Type::DICTIONARY);
+    entry.SetDoubleKey("size", static_cast<double>(sample.size) * sample.count);
+    entry.SetIntKey("nodeId", sample.node_id);
+    entry.SetDoubleKey("ordinal", static_cast<double>(sample.sample_id));
+    samples.Append(std::move(entry));
+  }
+
+  base::Value result(base::Value::Type::DICTIONARY);
+  result.SetKey("head",
+                SerializeHeapProfileNode(isolate, profile->GetRootNode()));
+  result.SetKey("samples", std::move(samples));
+
+  return WriteJSON(result);
+}
+
+}  // namespace
+
+JsProfiler::JsProfiler(v8::Isolate* isolate) : isolate_(isolate) {}
+
+JsProfiler::~JsProfiler() {
+  if (cpu_profiler_)
+    cpu_profiler_->Dispose();
+  if (heap_profiling_)
+    isolate_->GetHeapProfiler()->StopSamplingHeapProfiler();
+}
+
+bool JsProfiler::StartCpuProfiling(base::TimeDelta sampling_interval) {
+  if (cpu_profiler_)
+    return false;
+
+  // The profiler is only created while profiling, since it keeps V8 logging
+  // code events for as long as it exists.
+  v8::HandleScope handle_scope(isolate_);
+  cpu_profiler_ = v8::CpuProfiler::New(isolate_);
+  cpu_profiler_->SetSamplingInterval(sampling_interval.InMicroseconds());
+  cpu_profiler_->StartProfiling(gin::StringToV8(isolate_, kProfileTitle),
+                                true /* record_samples */);
+  return true;
+}
+
+base::Optional<std::string> JsProfiler::StopCpuProfiling() {
+  if (!cpu_profiler_)
+    return base::nullopt;
+
+  v8::HandleScope handle_scope(isolate_);
+  v8::CpuProfile* profile =
+      cpu_profiler_->StopProfiling(gin::StringToV8(isolate_, kProfileTitle));
+  base::Optional<std::string> result;
+  if (profile) {
+    result = SerializeCpuProfile(profile);
+    profile->Delete();
+  }
+
+  cpu_profiler_->Dispose();
+  cpu_profiler_ = nullptr;
+  return result;
+}
+
+bool JsProfiler::StartHeapProfiling(uint64_t sampling_interval,
+                                    int stack_depth) {
+  if (heap_profiling_)
+    return false;
+
+  heap_profiling_ = isolate_->GetHeapProfiler()->StartSamplingHeapProfiler(
+      sampling_interval, stack_depth);
+  return heap_profiling_;
+}
+
+base::Optional<std::string> JsProfiler::StopHeapProfiling() {
+  if (!heap_profiling_)
+    return base::nullopt;
+
+  v8::HandleScope handle_scope(isolate_);
+  v8::HeapProfiler* heap_profiler = isolate_->GetHeapProfiler();
+  std::unique_ptr<v8::AllocationProfile> profile(
+      heap_profiler->GetAllocationProfile());
+  heap_profiler->StopSamplingHeapProfiler();
+  heap_profiling_ = false;
+
+  if (!profile)
+    return base::nullopt;
+  return SerializeHeapProfile(isolate_, profile.get());
+}
+
+bool GetCpuProfilingOptions(gin::Arguments* args,
+                            base::TimeDelta* sampling_interval,
+                            std::string* error) {
+  gin_helper::Dictionary options;
+  args->GetNext(&options);
+  int interval = JsProfiler::kDefaultCpuSamplingInterval;
+  if (options.Get("samplingInterval", &interval) && interval <= 0) {
+    *error = "samplingInterval must be positive";
+    return false;
+  }
+  *sampling_interval = base::TimeDelta::FromMicroseconds(interval);
+  return true;
+}
+
+bool GetHeapProfilingOptions(gin::Arguments* args,
+                             uint64_t* sampling_interval,
+                             int* stack_depth,
+                             std::string* error) {
+  gin_helper::Dictionary options;
+  args->GetNext(&options);
+  int interval = JsProfiler::kDefaultHeapSamplingInterval;
+  if (options.Get("samplingInterval", &interval) && interval <= 0) {
+    *error = "samplingInterval must be positive";
+    return false;
+  }
+  int depth = JsProfiler::kDefaultHeapStackDepth;
+  if (options.Get("stackDepth", &depth) &&
+      (depth <= 0 || depth > JsProfiler::kMaxHeapStackDepth)) {
+    *error = "stackDepth must be between 1 and " +
+             base::NumberToString(JsProfiler::kMaxHeapStackDepth);
+    return false;
+  }
+  *sampling_interval = interval;
+  *stack_depth = depth;
+  return true;
+}
+
+}  // namespace electron
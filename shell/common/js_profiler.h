@@ -0,0 +1,71 @@
+// Copyright (c) 2020 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_JS_PROFILER_H_
+#define SHELL_COMMON_JS_PROFILER_H_
+
+#include <string>
+
+#include "base/macros.h"
+#include "base/optional.h"
+#include "base/time/time.h"
+#include "v8/include/v8.h"
+
+namespace gin {
+class Arguments;
+}
+
+namespace v8 {
+class CpuProfiler;
+}
+
+namespace electron {
+
+// Drives V8's CPU profiler and sampling heap profiler without going through
+// the inspector. Profiles are returned as JSON in the .cpuprofile and
+// .heapprofile formats that DevTools can load.
+class JsProfiler {
+ public:
+  // V8's own defaults, in microseconds and bytes.
+  static constexpr int kDefaultCpuSamplingInterval = 1000;
+  static constexpr int kDefaultHeapSamplingInterval = 512 * 1024;
+  static constexpr int kDefaultHeapStackDepth = 16;
+  // Keeps the serialized heap profile, which nests two levels per frame,
+  // within the 200 levels the JSON writer accepts.
+  static constexpr int kMaxHeapStackDepth = 96;
+
+  explicit JsProfiler(v8::Isolate* isolate);
+  ~JsProfiler();
+
+  // The Stop methods return base::nullopt when profiling was not started or
+  // the profile could not be serialized.
+  bool StartCpuProfiling(base::TimeDelta sampling_interval);
+  base::Optional<std::string> StopCpuProfiling();
+
+  // The heap profiler is per isolate, so this fails while another
+  // JsProfiler of the same isolate is already using it.
+  bool StartHeapProfiling(uint64_t sampling_interval, int stack_depth);
+  base::Optional<std::string> StopHeapProfiling();
+
+ private:
+  v8::Isolate* isolate_;
+  v8::CpuProfiler* cpu_profiler_ = nullptr;
+  bool heap_profiling_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(JsProfiler);
+};
+
+// Read the optional options object of the startCpuProfiling() and
+// startHeapProfiling() methods, setting |error| when it is invalid.
+bool GetCpuProfilingOptions(gin::Arguments* args,
+                            base::TimeDelta* sampling_interval,
+                            std::string* error);
+bool GetHeapProfilingOptions(gin::Arguments* args,
+                             uint64_t* sampling_interval,
+                             int* stack_depth,
+                             std::string* error);
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_JS_PROFILER_H_
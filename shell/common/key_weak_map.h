@@ -5,8 +5,8 @@
 #ifndef SHELL_COMMON_KEY_WEAK_MAP_H_
 #define SHELL_COMMON_KEY_WEAK_MAP_H_
 
+#include <deque>
 #include <unordered_map>
-#include <utility>
 #include <vector>
 
 #include "base/macros.h"
@@ -15,69 +15,139 @@
 namespace electron {
 
 // Like ES6's WeakMap, but the key is Integer and the value is Weak Pointer.
+//
+// Objects are kept in slots that never move and are reused once their object
+// is removed, so iterating walks the slots in order instead of hash map nodes
+// and adding an object only allocates when all the slots are in use. Empty
+// slots at the end are released, so the slots shrink as the last objects go.
 template <typename K>
 class KeyWeakMap {
  public:
   // Records the key and self, used by SetWeak.
   struct KeyObject {
     K key;
-    KeyWeakMap* self;
+    KeyWeakMap* self = nullptr;
+    size_t index = 0;
+    v8::Global<v8::Object> object;
   };
 
   KeyWeakMap() {}
   virtual ~KeyWeakMap() {
-    for (auto& p : map_)
-      p.second.second.ClearWeak();
+    for (auto& slot : slots_) {
+      if (!slot.object.IsEmpty())
+        slot.object.ClearWeak();
+    }
   }
 
   // Sets the object to WeakMap with the given |key|.
   void Set(v8::Isolate* isolate, const K& key, v8::Local<v8::Object> object) {
-    KeyObject key_object = {key, this};
-    auto& p = map_[key] =
-        std::make_pair(key_object, v8::Global<v8::Object>(isolate, object));
-    p.second.SetWeak(&(p.first), OnObjectGC, v8::WeakCallbackType::kParameter);
+    KeyObject* slot;
+    auto iter = index_.find(key);
+    if (iter != index_.end()) {
+      slot = &slots_[iter->second];
+    } else {
+      size_t index = TakeFreeSlot();
+      if (index == slots_.size())
+        slots_.emplace_back();
+      index_.emplace(key, index);
+      slot = &slots_[index];
+      slot->key = key;
+      slot->self = this;
+      slot->index = index;
+    }
+    slot->object.Reset(isolate, object);
+    slot->object.SetWeak(slot, OnObjectGC, v8::WeakCallbackType::kParameter);
   }
 
   // Gets the object from WeakMap by its |key|.
   v8::MaybeLocal<v8::Object> Get(v8::Isolate* isolate, const K& key) {
-    auto iter = map_.find(key);
-    if (iter == map_.end())
+    auto iter = index_.find(key);
+    if (iter == index_.end())
       return v8::MaybeLocal<v8::Object>();
     else
-      return v8::Local<v8::Object>::New(isolate, iter->second.second);
+      return v8::Local<v8::Object>::New(isolate, slots_[iter->second].object);
   }
 
   // Whethere there is an object with |key| in this WeakMap.
-  bool Has(const K& key) const { return map_.find(key) != map_.end(); }
+  bool Has(const K& key) const { return index_.find(key) != index_.end(); }
 
   // Returns all objects.
   std::vector<v8::Local<v8::Object>> Values(v8::Isolate* isolate) const {
     std::vector<v8::Local<v8::Object>> keys;
-    keys.reserve(map_.size());
-    for (const auto& it : map_)
-      keys.emplace_back(v8::Local<v8::Object>::New(isolate, it.second.second));
+    keys.reserve(index_.size());
+    for (const auto& slot : slots_) {
+      if (!slot.object.IsEmpty())
+        keys.emplace_back(v8::Local<v8::Object>::New(isolate, slot.object));
+    }
     return keys;
   }
 
+  // Returns the first object stored at or after |*cursor| and moves |*cursor|
+  // past it, starting from 0 visits every object. Objects added while
+  // iterating may reuse an earlier slot and be skipped.
+  v8::MaybeLocal<v8::Object> Next(v8::Isolate* isolate, size_t* cursor) const {
+    for (size_t i = *cursor; i < slots_.size(); ++i) {
+      if (!slots_[i].object.IsEmpty()) {
+        *cursor = i + 1;
+        return v8::Local<v8::Object>::New(isolate, slots_[i].object);
+      }
+    }
+    *cursor = slots_.size();
+    return v8::MaybeLocal<v8::Object>();
+  }
+
   // Remove object with |key| in the WeakMap.
   void Remove(const K& key) {
-    auto iter = map_.find(key);
-    if (iter == map_.end())
+    auto iter = index_.find(key);
+    if (iter == index_.end())
       return;
 
-    iter->second.second.ClearWeak();
-    map_.erase(iter);
+    size_t index = iter->second;
+    KeyObject& slot = slots_[index];
+    slot.object.ClearWeak();
+    slot.object.Reset();
+    index_.erase(iter);
+
+    if (index + 1 < slots_.size()) {
+      free_slots_.push_back(index);
+      return;
+    }
+    // Popping from the end of a std::deque keeps the other slots in place.
+    while (!slots_.empty() && slots_.back().object.IsEmpty())
+      slots_.pop_back();
+    if (slots_.empty())
+      free_slots_.clear();
   }
 
  private:
+  // Returns the index of an empty slot, or the size of |slots_| when there is
+  // none. |free_slots_| may still list slots released from the end since, or
+  // appended again and in use, which are skipped.
+  size_t TakeFreeSlot() {
+    while (!free_slots_.empty()) {
+      size_t index = free_slots_.back();
+      free_slots_.pop_back();
+      if (index < slots_.size() && slots_[index].object.IsEmpty())
+        return index;
+    }
+    return slots_.size();
+  }
+
   static void OnObjectGC(
       const v8::WeakCallbackInfo<typename KeyWeakMap<K>::KeyObject>& data) {
     KeyWeakMap<K>::KeyObject* key_object = data.GetParameter();
     key_object->self->Remove(key_object->key);
   }
 
-  // Map of stored objects.
-  std::unordered_map<K, std::pair<KeyObject, v8::Global<v8::Object>>> map_;
+  // Stored objects. std::deque never moves its elements when growing at the
+  // end, which keeps the address passed to the weak callbacks valid.
+  std::deque<KeyObject> slots_;
+
+  // Indices of the |slots_| whose object has been removed.
+  std::vector<size_t> free_slots_;
+
+  // Map of keys to their index in |slots_|.
+  std::unordered_map<K, size_t> index_;
 
   DISALLOW_COPY_AND_ASSIGN(KeyWeakMap);
 };
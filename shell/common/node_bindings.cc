@@ -8,6 +8,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <tuple>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "base/environment.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
+#include "base/stl_util.h"
 #include "base/strings/string_split.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -126,6 +128,31 @@ void stop_and_close_uv_loop(uv_loop_t* loop) {
 
 bool g_is_initialized = false;
 
+// Slices of the uv loop stop running timer and I/O callbacks after this long,
+// matching the threshold of long tasks, and slices which still ran longer are
+// reported as long slices.
+constexpr base::TimeDelta kUvSliceBudget =
+    base::TimeDelta::FromMilliseconds(50);
+
+// Upper bounds of the uv slice duration histogram buckets in milliseconds,
+// the last bucket collects everything longer.
+constexpr int64_t kUvSliceBucketBounds[] = {1, 4, 16, 50, 100};
+const char* const kUvSliceBucketNames[] = {
+    "UvSlices<1ms",  "UvSlices<4ms",   "UvSlices<16ms",
+    "UvSlices<50ms", "UvSlices<100ms", "UvSlices>=100ms",
+};
+static_assert(base::size(kUvSliceBucketNames) ==
+                  base::size(kUvSliceBucketBounds) + 1,
+              "every histogram bucket needs a name");
+
+// Number of JavaScript calls from native code that completed on the main
+// thread, which is what every uv callback reaching JavaScript goes through.
+size_t g_completed_js_calls = 0;
+
+void OnCallCompleted(v8::Isolate* isolate) {
+  ++g_completed_js_calls;
+}
+
 bool IsPackagedApp() {
   base::FilePath exe_path;
   base::PathService::Get(base::FILE_EXE, &exe_path);
@@ -271,17 +298,9 @@ NodeBindings::NodeBindings(BrowserEnvironment browser_env)
 }
 
 NodeBindings::~NodeBindings() {
-  // Quit the embed thread.
-  embed_closed_ = true;
-  uv_sem_post(&embed_sem_);
-
-  WakeupEmbedThread();
-
-  // Wait for everything to be done.
-  uv_thread_join(&embed_thread_);
+  StopPolling();
 
   // Clear uv.
-  uv_sem_destroy(&embed_sem_);
   dummy_uv_handle_.reset();
 
   // Clean up worker loop
@@ -352,6 +371,7 @@ void NodeBindings::Initialize() {
 node::Environment* NodeBindings::CreateEnvironment(
     v8::Handle<v8::Context> context,
     node::MultiIsolatePlatform* platform) {
+  TRACE_EVENT0("electron", "NodeBindings::CreateEnvironment");
 #if defined(OS_WIN)
   auto& atom_args = ElectronCommandLine::argv();
   std::vector<std::string> args(atom_args.size());
@@ -388,8 +408,11 @@ node::Environment* NodeBindings::CreateEnvironment(
 
   args.insert(args.begin() + 1, init_script);
 
-  isolate_data_ =
-      node::CreateIsolateData(context->GetIsolate(), uv_loop_, platform);
+  if (!isolate_data_ || !reuse_isolate_data_) {
+    TRACE_EVENT0("electron", "node::CreateIsolateData");
+    isolate_data_ =
+        node::CreateIsolateData(context->GetIsolate(), uv_loop_, platform);
+  }
 
   node::Environment* env;
   uint64_t flags = node::EnvironmentFlags::kDefaultFlags |
@@ -463,6 +486,7 @@ node::Environment* NodeBindings::CreateEnvironment(
 }
 
 void NodeBindings::LoadEnvironment(node::Environment* env) {
+  TRACE_EVENT0("electron", "NodeBindings::LoadEnvironment");
   node::LoadEnvironment(env);
   gin_helper::EmitEvent(env->isolate(), env->process_object(), "loaded");
 }
@@ -472,9 +496,31 @@ void NodeBindings::PrepareMessageLoop() {
   // nothing to do.
   uv_async_init(uv_loop_, dummy_uv_handle_.get(), nullptr);
 
+  StartPolling();
+}
+
+void NodeBindings::StartPolling() {
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
+  embed_thread_started_ = true;
+}
+
+void NodeBindings::StopPolling() {
+  if (!embed_thread_started_)
+    return;
+
+  // Quit the embed thread.
+  embed_closed_ = true;
+  uv_sem_post(&embed_sem_);
+
+  WakeupEmbedThread();
+
+  // Wait for everything to be done.
+  uv_thread_join(&embed_thread_);
+
+  uv_sem_destroy(&embed_sem_);
+  embed_thread_started_ = false;
 }
 
 void NodeBindings::RunMessageLoop() {
@@ -504,11 +550,40 @@ void NodeBindings::UvRunOnce() {
   // Perform microtask checkpoint after running JavaScript.
   gin_helper::MicrotasksScope microtasks_scope(env->isolate());
 
+  // Slices are only recorded while the "electron" category is traced, since
+  // the callback counting hook runs after every call into JavaScript. Worker
+  // threads have their own isolates and are not tracked.
+  bool trace_slices = false;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED("electron", &trace_slices);
+  trace_slices = trace_slices && !in_worker_loop();
+  if (trace_slices != counting_js_calls_) {
+    if (trace_slices)
+      env->isolate()->AddCallCompletedCallback(OnCallCompleted);
+    else
+      env->isolate()->RemoveCallCompletedCallback(OnCallCompleted);
+    counting_js_calls_ = trace_slices;
+  }
+
   if (browser_env_ != BrowserEnvironment::BROWSER)
     TRACE_EVENT_BEGIN0("devtools.timeline", "FunctionCall");
 
-  // Deal with uv events.
-  int r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+  // Deal with uv events. Callbacks left once the budget is used up run in the
+  // next slice, after the tasks that queued up in the meantime.
+  uv_loop_->callback_deadline = uv_hrtime() + kUvSliceBudget.InNanoseconds();
+  int r;
+  if (trace_slices) {
+    base::TimeTicks start = base::TimeTicks::Now();
+    size_t js_calls = g_completed_js_calls;
+    {
+      TRACE_EVENT0("electron", "NodeBindings::UvRunOnce");
+      r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+    }
+    RecordUvSlice(base::TimeTicks::Now() - start,
+                  g_completed_js_calls - js_calls);
+  } else {
+    r = uv_run(uv_loop_, UV_RUN_NOWAIT);
+  }
+  uv_loop_->callback_deadline = 0;
 
   if (browser_env_ != BrowserEnvironment::BROWSER)
     TRACE_EVENT_END0("devtools.timeline", "FunctionCall");
@@ -516,6 +591,30 @@ void NodeBindings::UvRunOnce() {
   if (r == 0)
     base::RunLoop().QuitWhenIdle();  // Quit from uv.
 
+  ResumePolling();
+}
+
+void NodeBindings::RecordUvSlice(base::TimeDelta duration, size_t callbacks) {
+  static_assert(base::size(kUvSliceBucketNames) ==
+                    std::tuple_size<decltype(uv_slice_histogram_)>::value,
+                "histogram size must match the number of buckets");
+  TRACE_COUNTER1("electron", "UvCallbacksPerSlice", callbacks);
+
+  size_t bucket = 0;
+  while (bucket < base::size(kUvSliceBucketBounds) &&
+         duration.InMilliseconds() >= kUvSliceBucketBounds[bucket])
+    ++bucket;
+  TRACE_COUNTER1("electron", kUvSliceBucketNames[bucket],
+                 ++uv_slice_histogram_[bucket]);
+
+  if (duration > kUvSliceBudget) {
+    TRACE_EVENT_INSTANT2("electron", "NodeBindings::LongUvSlice",
+                         TRACE_EVENT_SCOPE_THREAD, "duration_ms",
+                         duration.InMillisecondsF(), "callbacks", callbacks);
+  }
+}
+
+void NodeBindings::ResumePolling() {
   // Tell the worker thread to continue polling.
   uv_sem_post(&embed_sem_);
 }
@@ -5,12 +5,14 @@
 #ifndef SHELL_COMMON_NODE_BINDINGS_H_
 #define SHELL_COMMON_NODE_BINDINGS_H_
 
-#include <type_traits>
+#include <array>
 
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
+#include "shell/common/uv_handle.h"
 #include "uv.h"  // NOLINT(build/include_directory)
 #include "v8/include/v8.h"
 
@@ -26,54 +28,6 @@ class IsolateData;
 
 namespace electron {
 
-// A helper class to manage uv_handle_t types, e.g. uv_async_t.
-//
-// As per the uv docs: "uv_close() MUST be called on each handle before
-// memory is released. Moreover, the memory can only be released in
-// close_cb or after it has returned." This class encapsulates the work
-// needed to follow those requirements.
-template <typename T,
-          typename std::enable_if<
-              // these are the C-style 'subclasses' of uv_handle_t
-              std::is_same<T, uv_async_t>::value ||
-              std::is_same<T, uv_check_t>::value ||
-              std::is_same<T, uv_fs_event_t>::value ||
-              std::is_same<T, uv_fs_poll_t>::value ||
-              std::is_same<T, uv_idle_t>::value ||
-              std::is_same<T, uv_pipe_t>::value ||
-              std::is_same<T, uv_poll_t>::value ||
-              std::is_same<T, uv_prepare_t>::value ||
-              std::is_same<T, uv_process_t>::value ||
-              std::is_same<T, uv_signal_t>::value ||
-              std::is_same<T, uv_stream_t>::value ||
-              std::is_same<T, uv_tcp_t>::value ||
-              std::is_same<T, uv_timer_t>::value ||
-              std::is_same<T, uv_tty_t>::value ||
-              std::is_same<T, uv_udp_t>::value>::type* = nullptr>
-class UvHandle {
- public:
-  UvHandle() : t_(new T) {}
-  ~UvHandle() { reset(); }
-  T* get() { return t_; }
-  uv_handle_t* handle() { return reinterpret_cast<uv_handle_t*>(t_); }
-
-  void reset() {
-    auto* h = handle();
-    if (h != nullptr) {
-      DCHECK_EQ(0, uv_is_closing(h));
-      uv_close(h, OnClosed);
-      t_ = nullptr;
-    }
-  }
-
- private:
-  static void OnClosed(uv_handle_t* handle) {
-    delete reinterpret_cast<T*>(handle);
-  }
-
-  T* t_ = {};
-};
-
 class NodeBindings {
  public:
   enum class BrowserEnvironment { BROWSER, RENDERER, WORKER };
@@ -102,6 +56,11 @@ class NodeBindings {
 
   node::IsolateData* isolate_data() const { return isolate_data_; }
 
+  // When set, the isolate data is created once and shared by every
+  // environment created afterwards instead of being recreated for each one.
+  void set_reuse_isolate_data(bool reuse) { reuse_isolate_data_ = reuse; }
+  bool reuse_isolate_data() const { return reuse_isolate_data_; }
+
   // Gets/sets the environment to wrap uv loop.
   void set_uv_env(node::Environment* env) { uv_env_ = env; }
   node::Environment* uv_env() const { return uv_env_; }
@@ -119,6 +78,20 @@ class NodeBindings {
   // Run the libuv loop for once.
   void UvRunOnce();
 
+  // Start waiting for libuv events, by default in a thread running
+  // PollEvents().
+  virtual void StartPolling();
+
+  // Called after the libuv loop has run, to wait for its next events.
+  virtual void ResumePolling();
+
+  // Stops the thread running PollEvents(). Subclasses must call it before
+  // releasing what PollEvents() uses.
+  void StopPolling();
+
+  // Reports a run of the libuv loop to tracing.
+  void RecordUvSlice(base::TimeDelta duration, size_t callbacks);
+
   // Make the main thread run libuv loop.
   void WakeupMainThread();
 
@@ -138,6 +111,15 @@ class NodeBindings {
   // Thread to poll uv events.
   static void EmbedThreadRunner(void* arg);
 
+  // Whether completed JavaScript calls are counted for this isolate.
+  bool counting_js_calls_ = false;
+
+  // Number of libuv loop runs per duration bucket.
+  std::array<uint64_t, 6> uv_slice_histogram_ = {};
+
+  // Whether the embed thread has been started.
+  bool embed_thread_started_ = false;
+
   // Whether the libuv loop has ended.
   bool embed_closed_ = false;
 
@@ -159,6 +141,8 @@ class NodeBindings {
   // Isolate data used in creating the environment
   node::IsolateData* isolate_data_ = nullptr;
 
+  bool reuse_isolate_data_ = false;
+
   base::WeakPtrFactory<NodeBindings> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(NodeBindings);
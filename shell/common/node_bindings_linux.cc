@@ -4,20 +4,28 @@
 
 #include "shell/common/node_bindings_linux.h"
 
+#include <glib-unix.h>
 #include <sys/epoll.h>
+#include <unistd.h>
+
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "shell/common/options_switches.h"
 
 namespace electron {
 
 NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
-    : NodeBindings(browser_env), epoll_(epoll_create(1)) {
-  int backend_fd = uv_backend_fd(uv_loop_);
-  struct epoll_event ev = {0};
-  ev.events = EPOLLIN;
-  ev.data.fd = backend_fd;
-  epoll_ctl(epoll_, EPOLL_CTL_ADD, backend_fd, &ev);
-}
+    : NodeBindings(browser_env) {}
+
+NodeBindingsLinux::~NodeBindingsLinux() {
+  if (backend_fd_source_)
+    g_source_remove(backend_fd_source_);
 
-NodeBindingsLinux::~NodeBindingsLinux() = default;
+  // The embed thread waits on |epoll_|, so stop it before closing it.
+  StopPolling();
+  if (epoll_ >= 0)
+    close(epoll_);
+}
 
 void NodeBindingsLinux::RunMessageLoop() {
   // Get notified when libuv's watcher queue changes.
@@ -31,11 +39,80 @@ void NodeBindingsLinux::RunMessageLoop() {
 void NodeBindingsLinux::OnWatcherQueueChanged(uv_loop_t* loop) {
   NodeBindingsLinux* self = static_cast<NodeBindingsLinux*>(loop->data);
 
+  if (self->watch_backend_fd_) {
+    // New watchers are only added to the backend fd when the loop polls. A
+    // watcher added by a callback of the current run may come after that, so
+    // run the loop again once it returns.
+    if (self->uv_run_pending_)
+      self->watchers_changed_ = true;
+    else
+      self->ScheduleUvRunOnce();
+    return;
+  }
+
   // We need to break the io polling in the epoll thread when loop's watcher
   // queue changes, otherwise new events cannot be notified.
   self->WakeupEmbedThread();
 }
 
+// static
+gboolean NodeBindingsLinux::OnBackendFdReadable(gint fd,
+                                                GIOCondition condition,
+                                                gpointer user_data) {
+  NodeBindingsLinux* self = static_cast<NodeBindingsLinux*>(user_data);
+  self->backend_fd_source_ = 0;
+  self->ScheduleUvRunOnce();
+  // The fd stays readable until the loop has run, so stop watching it until
+  // then rather than having the pump spin.
+  return G_SOURCE_REMOVE;
+}
+
+void NodeBindingsLinux::StartPolling() {
+  // The browser process runs a glib message pump on the UI thread, which can
+  // watch the backend fd directly when asked to. The switch is read here so
+  // the main script can still append it.
+  watch_backend_fd_ =
+      browser_env_ == BrowserEnvironment::BROWSER &&
+      base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableUvGlibIntegration);
+  if (watch_backend_fd_)
+    return;
+
+  epoll_ = epoll_create(1);
+  int backend_fd = uv_backend_fd(uv_loop_);
+  struct epoll_event ev = {0};
+  ev.events = EPOLLIN;
+  ev.data.fd = backend_fd;
+  epoll_ctl(epoll_, EPOLL_CTL_ADD, backend_fd, &ev);
+
+  NodeBindings::StartPolling();
+}
+
+void NodeBindingsLinux::ResumePolling() {
+  if (!watch_backend_fd_) {
+    NodeBindings::ResumePolling();
+    return;
+  }
+
+  uv_run_pending_ = false;
+  if (watchers_changed_) {
+    watchers_changed_ = false;
+    uv_timer_.Stop();
+    ScheduleUvRunOnce();
+    return;
+  }
+  WatchBackendFd();
+
+  int timeout = uv_backend_timeout(uv_loop_);
+  if (timeout >= 0) {
+    uv_timer_.Start(FROM_HERE, base::TimeDelta::FromMilliseconds(timeout),
+                    base::BindOnce(&NodeBindingsLinux::ScheduleUvRunOnce,
+                                   base::Unretained(this)));
+  } else {
+    uv_timer_.Stop();
+  }
+}
+
 void NodeBindingsLinux::PollEvents() {
   int timeout = uv_backend_timeout(uv_loop_);
 
@@ -47,6 +124,20 @@ void NodeBindingsLinux::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+void NodeBindingsLinux::ScheduleUvRunOnce() {
+  if (uv_run_pending_)
+    return;
+  uv_run_pending_ = true;
+  WakeupMainThread();
+}
+
+void NodeBindingsLinux::WatchBackendFd() {
+  if (backend_fd_source_)
+    return;
+  backend_fd_source_ = g_unix_fd_add(uv_backend_fd(uv_loop_), G_IO_IN,
+                                     OnBackendFdReadable, this);
+}
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsLinux(browser_env);
@@ -5,7 +5,10 @@
 #ifndef SHELL_COMMON_NODE_BINDINGS_LINUX_H_
 #define SHELL_COMMON_NODE_BINDINGS_LINUX_H_
 
+#include <glib.h>
+
 #include "base/compiler_specific.h"
+#include "base/timer/timer.h"
 #include "shell/common/node_bindings.h"
 
 namespace electron {
@@ -21,10 +24,39 @@ class NodeBindingsLinux : public NodeBindings {
   // Called when uv's watcher queue changes.
   static void OnWatcherQueueChanged(uv_loop_t* loop);
 
+  // Called by glib when uv's backend fd becomes readable.
+  static gboolean OnBackendFdReadable(gint fd,
+                                      GIOCondition condition,
+                                      gpointer user_data);
+
+  void StartPolling() override;
+  void ResumePolling() override;
   void PollEvents() override;
 
-  // Epoll to poll for uv's backend fd.
-  int epoll_;
+  // Runs the uv loop from a task, unless one is already pending.
+  void ScheduleUvRunOnce();
+  void WatchBackendFd();
+
+  // Whether uv's backend fd is watched by the glib main context the UI
+  // thread's message pump runs, instead of by the embed thread. Decided when
+  // polling starts.
+  bool watch_backend_fd_ = false;
+
+  // Id of the glib source watching uv's backend fd, 0 when not watching.
+  guint backend_fd_source_ = 0;
+
+  // Whether a task running the uv loop has been posted, which stays true
+  // until the loop has run.
+  bool uv_run_pending_ = false;
+
+  // Whether uv's watcher queue changed while a run was pending.
+  bool watchers_changed_ = false;
+
+  // Fires when the closest uv timer is due.
+  base::OneShotTimer uv_timer_;
+
+  // Epoll to poll for uv's backend fd, only created for the embed thread.
+  int epoll_ = -1;
 
   DISALLOW_COPY_AND_ASSIGN(NodeBindingsLinux);
 };
@@ -3,6 +3,10 @@
 // found in the LICENSE file.
 
 #include "shell/common/node_util.h"
+
+#include <algorithm>
+#include <memory>
+
 #include "base/logging.h"
 #include "shell/common/node_includes.h"
 #include "third_party/electron_node/src/node_native_module_env.h"
@@ -36,6 +40,33 @@ v8::MaybeLocal<v8::Value> CompileAndCall(
   return ret;
 }
 
+std::vector<uint8_t> CreateCodeCache(
+    v8::Local<v8::Context> context,
+    const char* id,
+    std::vector<v8::Local<v8::String>>* parameters) {
+  v8::TryCatch try_catch(context->GetIsolate());
+  v8::Local<v8::Function> fn;
+  if (!node::native_module::NativeModuleEnv::LookupAndCompile(
+           context, id, parameters, nullptr)
+           .ToLocal(&fn))
+    return {};
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data(
+      v8::ScriptCompiler::CreateCodeCacheForFunction(fn));
+  if (!cached_data)
+    return {};
+  return std::vector<uint8_t>(cached_data->data,
+                              cached_data->data + cached_data->length);
+}
+
+void SetCodeCache(const char* id, base::span<const uint8_t> data) {
+  auto* buffer = new uint8_t[data.size()];
+  std::copy(data.begin(), data.end(), buffer);
+  node::native_module::NativeModuleEnv::SetCodeCache(
+      id, std::make_unique<v8::ScriptCompiler::CachedData>(
+              buffer, static_cast<int>(data.size()),
+              v8::ScriptCompiler::CachedData::BufferOwned));
+}
+
 }  // namespace util
 
 }  // namespace electron
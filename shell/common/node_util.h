@@ -7,6 +7,7 @@
 
 #include <vector>
 
+#include "base/containers/span.h"
 #include "v8/include/v8.h"
 
 namespace node {
@@ -29,6 +30,19 @@ v8::MaybeLocal<v8::Value> CompileAndCall(
     std::vector<v8::Local<v8::Value>>* arguments,
     node::Environment* optional_env);
 
+// Compiles the bundle |id| with |parameters| and returns a code cache for it,
+// which is empty on failure. The cache covers every function of the bundle,
+// since Node compiles bundles eagerly when it has no cache for them.
+std::vector<uint8_t> CreateCodeCache(
+    v8::Local<v8::Context> context,
+    const char* id,
+    std::vector<v8::Local<v8::String>>* parameters);
+
+// Makes the next compilation of the bundle |id| in this process consume
+// |data|. V8 rejects caches that don't match its version, flags or the
+// bundle's source, and compiles the bundle as usual then.
+void SetCodeCache(const char* id, base::span<const uint8_t> data);
+
 }  // namespace util
 
 }  // namespace electron
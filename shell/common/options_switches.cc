@@ -191,6 +191,9 @@ const char kEnableRemoteModule[] = "enableRemoteModule";
 
 const char kEnableWebSQL[] = "enableWebSQL";
 
+// Keep the Node.js isolate data of the renderer process across navigations.
+const char kReuseNodeIsolateData[] = "reuseNodeIsolateData";
+
 }  // namespace options
 
 namespace switches {
@@ -267,6 +270,10 @@ const char kNodeIntegrationInSubFrames[] = "node-integration-in-subframes";
 // is allowed.
 const char kEnableWebSQL[] = "enable-websql";
 
+// Command switch passed to renderer process to keep the Node.js isolate data
+// alive across the node environments it creates.
+const char kReuseNodeIsolateData[] = "reuse-node-isolate-data";
+
 // Widevine options
 // Path to Widevine CDM binaries.
 const char kWidevineCdmPath[] = "widevine-cdm-path";
@@ -292,6 +299,10 @@ const char kEnableAuthNegotiatePort[] = "enable-auth-negotiate-port";
 // If set, NTLM v2 is disabled for POSIX platforms.
 const char kDisableNTLMv2[] = "disable-ntlm-v2";
 
+// Runs libuv's loop from the glib main context of the browser process' UI
+// thread on Linux, instead of polling it from a separate thread.
+const char kEnableUvGlibIntegration[] = "enable-uv-glib-integration";
+
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
 const char kEnableSpellcheck[] = "enable-spellcheck";
 #endif
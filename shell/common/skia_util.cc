@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <string>
+#include <vector>
 
 #include "base/files/file_util.h"
 #include "base/strings/pattern.h"
@@ -120,11 +121,12 @@ bool AddImageSkiaRepFromBuffer(gfx::ImageSkia* image,
 
 bool AddImageSkiaRepFromPath(gfx::ImageSkia* image,
                              const base::FilePath& path,
-                             double scale_factor) {
+                             double scale_factor,
+                             std::shared_ptr<asar::Archive>* archive) {
   std::string file_contents;
   {
     base::ThreadRestrictions::ScopedAllowIO allow_io;
-    if (!asar::ReadFileToString(path, &file_contents))
+    if (!asar::ReadFileToString(path, &file_contents, archive))
       return false;
   }
 
@@ -136,20 +138,36 @@ bool AddImageSkiaRepFromPath(gfx::ImageSkia* image,
 }
 
 bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
-                                   const base::FilePath& path) {
+                                   const base::FilePath& path,
+                                   std::shared_ptr<asar::Archive>* archive) {
   bool succeed = false;
   std::string filename(path.BaseName().RemoveExtension().AsUTF8Unsafe());
   if (base::MatchPattern(filename, "*@*x"))
     // Don't search for other representations if the DPI has been specified.
-    return AddImageSkiaRepFromPath(image, path, GetScaleFactorFromPath(path));
+    return AddImageSkiaRepFromPath(image, path, GetScaleFactorFromPath(path),
+                                   archive);
   else
-    succeed |= AddImageSkiaRepFromPath(image, path, 1.0f);
+    succeed |= AddImageSkiaRepFromPath(image, path, 1.0f, archive);
 
   for (const ScaleFactorPair& pair : kScaleFactorPairs)
     succeed |= AddImageSkiaRepFromPath(
-        image, path.InsertBeforeExtensionASCII(pair.name), pair.scale);
+        image, path.InsertBeforeExtensionASCII(pair.name), pair.scale,
+        archive);
   return succeed;
 }
+
+std::vector<base::FilePath> GetImageSkiaRepPathsFromPath(
+    const base::FilePath& path) {
+  std::vector<base::FilePath> paths = {path};
+  std::string filename(path.BaseName().RemoveExtension().AsUTF8Unsafe());
+  if (base::MatchPattern(filename, "*@*x"))
+    return paths;
+
+  for (const ScaleFactorPair& pair : kScaleFactorPairs)
+    paths.push_back(path.InsertBeforeExtensionASCII(pair.name));
+  return paths;
+}
+
 #if defined(OS_WIN)
 bool ReadImageSkiaFromICO(gfx::ImageSkia* image, HICON icon) {
   // Convert the icon from the Windows specific HICON to gfx::ImageSkia.
@@ -5,16 +5,30 @@
 #ifndef SHELL_COMMON_SKIA_UTIL_H_
 #define SHELL_COMMON_SKIA_UTIL_H_
 
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "base/files/file_path.h"
 #include "ui/gfx/image/image_skia.h"
 
+namespace asar {
+class Archive;
+}
+
 namespace electron {
 
 namespace util {
 
-bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
-                                   const base::FilePath& path);
+// |archive| is passed on to asar::ReadFileToString() for every file read.
+bool PopulateImageSkiaRepsFromPath(
+    gfx::ImageSkia* image,
+    const base::FilePath& path,
+    std::shared_ptr<asar::Archive>* archive = nullptr);
+
+// Returns the files PopulateImageSkiaRepsFromPath() may read for |path|.
+std::vector<base::FilePath> GetImageSkiaRepPathsFromPath(
+    const base::FilePath& path);
 
 bool AddImageSkiaRepFromBuffer(gfx::ImageSkia* image,
                                const unsigned char* data,
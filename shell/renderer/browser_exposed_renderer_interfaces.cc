@@ -4,20 +4,61 @@
 
 #include "shell/renderer/browser_exposed_renderer_interfaces.h"
 
+#include <memory>
+#include <string>
 #include <utility>
 
 #include "base/bind.h"
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "build/build_config.h"
 #include "electron/buildflags/buildflags.h"
+#include "electron/shell/common/api/api.mojom.h"
+#include "mojo/public/cpp/base/big_buffer.h"
 #include "mojo/public/cpp/bindings/binder_map.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "shell/common/node_util.h"
 #include "shell/renderer/renderer_client_base.h"
+#include "v8/include/v8.h"
 
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
 #include "components/spellcheck/renderer/spellcheck.h"
 #endif
 
 namespace {
+
+class ElectronBundleCodeCacheImpl
+    : public electron::mojom::ElectronBundleCodeCache {
+ public:
+  ElectronBundleCodeCacheImpl() = default;
+  ~ElectronBundleCodeCacheImpl() override = default;
+
+  static void Bind(
+      mojo::PendingReceiver<electron::mojom::ElectronBundleCodeCache>
+          receiver) {
+    mojo::MakeSelfOwnedReceiver(std::make_unique<ElectronBundleCodeCacheImpl>(),
+                                std::move(receiver));
+  }
+
+  // electron::mojom::ElectronBundleCodeCache
+  void SetCodeCaches(
+      uint32_t version_tag,
+      base::flat_map<std::string, mojo_base::BigBuffer> caches) override {
+    // V8 would reject caches produced with other flags than this renderer's.
+    if (version_tag != v8::ScriptCompiler::CachedDataVersionTag())
+      return;
+    for (const auto& cache : caches) {
+      electron::util::SetCodeCache(
+          cache.first.c_str(),
+          base::make_span(cache.second.data(), cache.second.size()));
+    }
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ElectronBundleCodeCacheImpl);
+};
+
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
 void BindSpellChecker(
     electron::RendererClientBase* client,
@@ -32,6 +73,8 @@ void BindSpellChecker(
 void ExposeElectronRendererInterfacesToBrowser(
     electron::RendererClientBase* client,
     mojo::BinderMap* binders) {
+  binders->Add(base::BindRepeating(&ElectronBundleCodeCacheImpl::Bind),
+               base::SequencedTaskRunnerHandle::Get());
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   binders->Add(base::BindRepeating(&BindSpellChecker, client),
                base::SequencedTaskRunnerHandle::Get());
@@ -12,17 +12,21 @@
 #include "base/macros.h"
 #include "base/threading/thread_restrictions.h"
 #include "gin/data_object_builder.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/system/platform_handle.h"
+#include "mojo/public/cpp/system/wait.h"
 #include "shell/common/electron_constants.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/heap_snapshot.h"
+#include "shell/common/js_profiler.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
 #include "shell/common/v8_value_serializer.h"
 #include "shell/renderer/electron_render_frame_observer.h"
 #include "shell/renderer/renderer_client_base.h"
 #include "third_party/blink/public/mojom/frame/user_activation_notification_type.mojom-shared.h"
+#include "third_party/blink/public/platform/web_cache.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_message_port_converter.h"
@@ -48,6 +52,27 @@ v8::Local<v8::Object> GetIpcObject(v8::Local<v8::Context> context) {
   return value->ToObject(context).ToLocalChecked();
 }
 
+// Writes |data| to |producer|, waiting for the browser to drain the pipe
+// whenever it is full. Fails once the browser closes its end.
+bool WriteToDataPipe(mojo::DataPipeProducerHandle producer,
+                     base::span<const uint8_t> data) {
+  while (!data.empty()) {
+    uint32_t size = data.size();
+    MojoResult result =
+        producer.WriteData(data.data(), &size, MOJO_WRITE_DATA_FLAG_NONE);
+    if (result == MOJO_RESULT_SHOULD_WAIT) {
+      result = mojo::Wait(producer, MOJO_HANDLE_SIGNAL_WRITABLE);
+      if (result != MOJO_RESULT_OK)
+        return false;
+      continue;
+    }
+    if (result != MOJO_RESULT_OK)
+      return false;
+    data = data.subspan(size);
+  }
+  return true;
+}
+
 void InvokeIpcCallback(v8::Local<v8::Context> context,
                        const std::string& callback_name,
                        std::vector<v8::Local<v8::Value>> args) {
@@ -219,9 +244,38 @@ void ElectronApiServiceImpl::NotifyUserActivation() {
 
 void ElectronApiServiceImpl::TakeHeapSnapshot(
     mojo::ScopedHandle file,
+    mojo::ScopedDataPipeProducerHandle data,
+    bool compress,
+    mojo::PendingAssociatedRemote<mojom::HeapSnapshotObserver> observer,
     TakeHeapSnapshotCallback callback) {
   base::ThreadRestrictions::ScopedAllowIO allow_io;
 
+  HeapSnapshotOptions options;
+  options.compress = compress;
+
+  // Sending over |remote| only queues the messages, so it is safe to do
+  // while V8 is walking the heap.
+  mojo::AssociatedRemote<mojom::HeapSnapshotObserver> remote;
+  if (observer) {
+    remote.Bind(std::move(observer));
+    options.progress = base::BindRepeating(
+        &mojom::HeapSnapshotObserver::OnProgress, base::Unretained(remote.get()));
+  }
+
+  if (!file.is_valid()) {
+    if (!data.is_valid()) {
+      std::move(callback).Run(false);
+      return;
+    }
+    bool success = electron::TakeHeapSnapshot(
+        blink::MainThreadIsolate(),
+        base::BindRepeating(&WriteToDataPipe, data.get()), options);
+    // Closing the pipe tells the browser it has seen the last chunk.
+    data.reset();
+    std::move(callback).Run(success);
+    return;
+  }
+
   base::PlatformFile platform_file;
   if (mojo::UnwrapPlatformFile(std::move(file), &platform_file) !=
       MOJO_RESULT_OK) {
@@ -231,10 +285,58 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
   }
   base::File base_file(platform_file);
 
-  bool success =
-      electron::TakeHeapSnapshot(blink::MainThreadIsolate(), &base_file);
+  bool success = electron::TakeHeapSnapshot(blink::MainThreadIsolate(),
+                                            &base_file, options);
 
   std::move(callback).Run(success);
 }
 
+void ElectronApiServiceImpl::GetResourceUsage(
+    GetResourceUsageCallback callback) {
+  v8::HeapStatistics heap_statistics;
+  blink::MainThreadIsolate()->GetHeapStatistics(&heap_statistics);
+  blink::WebCacheResourceTypeStats cache_stats;
+  blink::WebCache::GetResourceTypeStats(&cache_stats);
+
+  auto usage = mojom::RendererResourceUsage::New();
+  usage->js_heap_used_size = heap_statistics.used_heap_size();
+  usage->js_heap_total_size = heap_statistics.total_heap_size();
+  usage->blink_cache_size =
+      cache_stats.images.size + cache_stats.css_style_sheets.size +
+      cache_stats.scripts.size + cache_stats.xsl_style_sheets.size +
+      cache_stats.fonts.size + cache_stats.other.size;
+  std::move(callback).Run(std::move(usage));
+}
+
+JsProfiler* ElectronApiServiceImpl::GetJsProfiler() {
+  if (!js_profiler_)
+    js_profiler_ = std::make_unique<JsProfiler>(blink::MainThreadIsolate());
+  return js_profiler_.get();
+}
+
+void ElectronApiServiceImpl::StartCpuProfiling(
+    int32_t sampling_interval_us,
+    StartCpuProfilingCallback callback) {
+  std::move(callback).Run(GetJsProfiler()->StartCpuProfiling(
+      base::TimeDelta::FromMicroseconds(sampling_interval_us)));
+}
+
+void ElectronApiServiceImpl::StopCpuProfiling(
+    StopCpuProfilingCallback callback) {
+  std::move(callback).Run(GetJsProfiler()->StopCpuProfiling());
+}
+
+void ElectronApiServiceImpl::StartHeapProfiling(
+    uint64_t sampling_interval,
+    int32_t stack_depth,
+    StartHeapProfilingCallback callback) {
+  std::move(callback).Run(
+      GetJsProfiler()->StartHeapProfiling(sampling_interval, stack_depth));
+}
+
+void ElectronApiServiceImpl::StopHeapProfiling(
+    StopHeapProfilingCallback callback) {
+  std::move(callback).Run(GetJsProfiler()->StopHeapProfiling());
+}
+
 }  // namespace electron
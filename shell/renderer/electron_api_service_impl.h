@@ -5,6 +5,7 @@
 #ifndef SHELL_RENDERER_ELECTRON_API_SERVICE_IMPL_H_
 #define SHELL_RENDERER_ELECTRON_API_SERVICE_IMPL_H_
 
+#include <memory>
 #include <string>
 
 #include "base/memory/weak_ptr.h"
@@ -14,9 +15,11 @@
 #include "electron/shell/common/api/api.mojom.h"
 #include "mojo/public/cpp/bindings/associated_receiver.h"
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
+#include "mojo/public/cpp/bindings/pending_associated_remote.h"
 
 namespace electron {
 
+class JsProfiler;
 class RendererClientBase;
 
 class ElectronApiServiceImpl : public mojom::ElectronRenderer,
@@ -36,8 +39,20 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
   void ReceivePostMessage(const std::string& channel,
                           blink::TransferableMessage message) override;
   void NotifyUserActivation() override;
-  void TakeHeapSnapshot(mojo::ScopedHandle file,
-                        TakeHeapSnapshotCallback callback) override;
+  void TakeHeapSnapshot(
+      mojo::ScopedHandle file,
+      mojo::ScopedDataPipeProducerHandle data,
+      bool compress,
+      mojo::PendingAssociatedRemote<mojom::HeapSnapshotObserver> observer,
+      TakeHeapSnapshotCallback callback) override;
+  void GetResourceUsage(GetResourceUsageCallback callback) override;
+  void StartCpuProfiling(int32_t sampling_interval_us,
+                         StartCpuProfilingCallback callback) override;
+  void StopCpuProfiling(StopCpuProfilingCallback callback) override;
+  void StartHeapProfiling(uint64_t sampling_interval,
+                          int32_t stack_depth,
+                          StartHeapProfilingCallback callback) override;
+  void StopHeapProfiling(StopHeapProfilingCallback callback) override;
 
   base::WeakPtr<ElectronApiServiceImpl> GetWeakPtr() {
     return weak_factory_.GetWeakPtr();
@@ -52,9 +67,14 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
 
   void OnConnectionError();
 
+  JsProfiler* GetJsProfiler();
+
   // Whether the DOM document element has been created.
   bool document_created_ = false;
 
+  // Created on first use.
+  std::unique_ptr<JsProfiler> js_profiler_;
+
   mojo::AssociatedReceiver<mojom::ElectronRenderer> receiver_{this};
 
   RendererClientBase* renderer_client_;
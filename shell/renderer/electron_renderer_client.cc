@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/time/time.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/buildflags/buildflags.h"
 #include "shell/common/api/electron_bindings.h"
@@ -120,12 +121,20 @@ void ElectronRendererClient::DidCreateScriptContext(
   if (!node::tracing::TraceEventHelper::GetAgent())
     node::tracing::TraceEventHelper::SetAgent(node::CreateAgent());
 
+  // Keep the isolate data warm across the environments of this process.
+  if (command_line->HasSwitch(switches::kReuseNodeIsolateData))
+    node_bindings_->set_reuse_isolate_data(true);
+  bool isolate_data_reused = node_bindings_->reuse_isolate_data() &&
+                             node_bindings_->isolate_data() != nullptr;
+
   // Setup node environment for each window.
+  base::TimeTicks start_time = base::TimeTicks::Now();
   bool initialized = node::InitializeContext(renderer_context);
   CHECK(initialized);
 
   node::Environment* env =
       node_bindings_->CreateEnvironment(renderer_context, nullptr);
+  base::TimeTicks created_time = base::TimeTicks::Now();
 
   // If we have disabled the site instance overrides we should prevent loading
   // any non-context aware native module
@@ -144,6 +153,13 @@ void ElectronRendererClient::DidCreateScriptContext(
   // Load everything.
   node_bindings_->LoadEnvironment(env);
 
+  gin_helper::Dictionary metrics = gin::Dictionary::CreateEmpty(env->isolate());
+  metrics.Set("createTime", (created_time - start_time).InMillisecondsF());
+  metrics.Set("loadTime",
+              (base::TimeTicks::Now() - created_time).InMillisecondsF());
+  metrics.Set("isolateDataReused", isolate_data_reused);
+  process_dict.SetReadOnly("contextCreationMetrics", metrics.GetHandle());
+
   if (node_bindings_->uv_env() == nullptr) {
     // Make uv loop being wrapped by window context.
     node_bindings_->set_uv_env(env);
@@ -179,7 +195,8 @@ void ElectronRendererClient::WillReleaseScriptContext(
       command_line->HasSwitch(
           switches::kDisableElectronSiteInstanceOverrides)) {
     node::FreeEnvironment(env);
-    if (env == node_bindings_->uv_env())
+    if (env == node_bindings_->uv_env() &&
+        !node_bindings_->reuse_isolate_data())
       node::FreeIsolateData(node_bindings_->isolate_data());
   }
 
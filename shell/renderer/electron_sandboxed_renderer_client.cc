@@ -4,11 +4,14 @@
 
 #include "shell/renderer/electron_sandboxed_renderer_client.h"
 
+#include <vector>
+
 #include "base/base_paths.h"
 #include "base/command_line.h"
 #include "base/files/file_path.h"
 #include "base/path_service.h"
 #include "base/process/process_handle.h"
+#include "base/stl_util.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/buildflags/buildflags.h"
 #include "shell/common/api/electron_bindings.h"
@@ -83,10 +86,56 @@ v8::Local<v8::Value> GetBinding(v8::Isolate* isolate,
   return exports;
 }
 
-v8::Local<v8::Value> CreatePreloadScript(v8::Isolate* isolate,
-                                         v8::Local<v8::String> preloadSrc) {
-  return RendererClientBase::RunScript(isolate->GetCurrentContext(),
-                                       preloadSrc);
+// Compiles |source| as the body of the function preload scripts are wrapped
+// in. When the browser supplied a code cache for the script it is consumed
+// instead of parsing and compiling the source from scratch.
+v8::Local<v8::Value> CompilePreloadScript(v8::Isolate* isolate,
+                                          v8::Local<v8::String> path,
+                                          v8::Local<v8::String> source,
+                                          gin_helper::Arguments* args) {
+  auto context = isolate->GetCurrentContext();
+
+  // Keep in sync with |wrapperParams| in lib/browser/preload-cache.ts.
+  v8::Local<v8::String> params[] = {
+      gin::StringToV8(isolate, "require"),
+      gin::StringToV8(isolate, "process"),
+      gin::StringToV8(isolate, "Buffer"),
+      gin::StringToV8(isolate, "global"),
+      gin::StringToV8(isolate, "setImmediate"),
+      gin::StringToV8(isolate, "clearImmediate"),
+      gin::StringToV8(isolate, "exports"),
+  };
+
+  std::vector<uint8_t> cache;
+  v8::Local<v8::Value> cache_value;
+  if (args->GetNext(&cache_value) && cache_value->IsArrayBufferView()) {
+    auto view = cache_value.As<v8::ArrayBufferView>();
+    cache.resize(view->ByteLength());
+    view->CopyContents(cache.data(), cache.size());
+  }
+
+  v8::ScriptOrigin origin(path);
+  v8::ScriptCompiler::CachedData* cached_data = nullptr;
+  if (!cache.empty()) {
+    cached_data = new v8::ScriptCompiler::CachedData(
+        cache.data(), cache.size(),
+        v8::ScriptCompiler::CachedData::BufferNotOwned);
+  }
+  // |script_source| takes ownership of |cached_data|.
+  v8::ScriptCompiler::Source script_source(source, origin, cached_data);
+  v8::Local<v8::Function> fn;
+  if (!v8::ScriptCompiler::CompileFunctionInContext(
+           context, &script_source, base::size(params), params, 0, nullptr,
+           cached_data ? v8::ScriptCompiler::kConsumeCodeCache
+                       : v8::ScriptCompiler::kNoCompileOptions)
+           .ToLocal(&fn))
+    return v8::Local<v8::Value>();
+
+  gin_helper::Dictionary result = gin::Dictionary::CreateEmpty(isolate);
+  result.Set("fn", fn);
+  if (cached_data)
+    result.Set("cachedDataRejected", static_cast<bool>(cached_data->rejected));
+  return result.GetHandle();
 }
 
 void InvokeHiddenCallback(v8::Handle<v8::Context> context,
@@ -129,7 +178,10 @@ void ElectronSandboxedRendererClient::InitializeBindings(
   auto* isolate = context->GetIsolate();
   gin_helper::Dictionary b(isolate, binding);
   b.SetMethod("get", GetBinding);
-  b.SetMethod("createPreloadScript", CreatePreloadScript);
+  b.SetMethod("compilePreloadScript", CompilePreloadScript);
+  // The browser only hands out code caches produced with the same V8 version
+  // and flags, which this tag identifies.
+  b.Set("cachedDataVersionTag", v8::ScriptCompiler::CachedDataVersionTag());
 
   gin_helper::Dictionary process = gin::Dictionary::CreateEmpty(isolate);
   b.Set("process", process);
@@ -9,7 +9,7 @@ import { promisify } from 'util';
 import { app, BrowserWindow, Menu, session } from 'electron/main';
 import { emittedOnce } from './events-helpers';
 import { closeWindow, closeAllWindows } from './window-helpers';
-import { ifdescribe, ifit } from './spec-helpers';
+import { ifdescribe, ifit, delay } from './spec-helpers';
 import split = require('split')
 
 const features = process._linkedBinding('electron_common_features');
@@ -1158,6 +1158,69 @@ describe('app module', () => {
     });
   });
 
+  describe('setSpareRendererPoolSize() API', () => {
+    const webPreferences = { partition: 'spare-renderer-pool' };
+    afterEach(async () => {
+      app.setSpareRendererPoolSize(0, webPreferences);
+      await closeAllWindows();
+    });
+
+    it('hands a spare renderer to a window with matching webPreferences', async () => {
+      app.setSpareRendererPoolSize(1, webPreferences);
+      while (app.getSpareRendererPoolStats().count < 1) {
+        await new Promise(resolve => setTimeout(resolve, 10));
+      }
+      const { hits } = app.getSpareRendererPoolStats();
+      const w = new BrowserWindow({ show: false, webPreferences });
+      expect(app.getSpareRendererPoolStats().hits).to.equal(hits + 1);
+      await w.loadURL('about:blank');
+    });
+
+    it('does not hand spare renderers to other windows', async () => {
+      app.setSpareRendererPoolSize(1, webPreferences);
+      const { hits } = app.getSpareRendererPoolStats();
+      const w = new BrowserWindow({ show: false, webPreferences: { partition: 'other' } });
+      expect(app.getSpareRendererPoolStats().hits).to.equal(hits);
+      await w.loadURL('about:blank');
+    });
+
+    it('does not hand spare renderers to windows with other window options', async () => {
+      app.setSpareRendererPoolSize(1, webPreferences);
+      while (app.getSpareRendererPoolStats().count < 1) {
+        await delay(10);
+      }
+      const { hits } = app.getSpareRendererPoolStats();
+      const w1 = new BrowserWindow({ show: false, backgroundColor: '#ff0000', webPreferences });
+      const w2 = new BrowserWindow({ show: false, transparent: true, webPreferences });
+      expect(app.getSpareRendererPoolStats().hits).to.equal(hits);
+      await w1.loadURL('about:blank');
+      await w2.loadURL('about:blank');
+    });
+
+    it('pools windows whose window options are part of the pool webPreferences', async () => {
+      const pooled = { ...webPreferences, backgroundColor: '#ff0000' };
+      app.setSpareRendererPoolSize(1, pooled);
+      try {
+        while (app.getSpareRendererPoolStats().count < 1) {
+          await delay(10);
+        }
+        const { hits } = app.getSpareRendererPoolStats();
+        const w = new BrowserWindow({ show: false, backgroundColor: '#ff0000', webPreferences });
+        expect(app.getSpareRendererPoolStats().hits).to.equal(hits + 1);
+        expect(w.getBackgroundColor()).to.equal('#FF0000');
+        await w.loadURL('about:blank');
+      } finally {
+        app.setSpareRendererPoolSize(0, pooled);
+      }
+    });
+
+    it('throws for webPreferences with a session', () => {
+      expect(() => {
+        app.setSpareRendererPoolSize(1, { session: session.defaultSession });
+      }).to.throw(/can not be pooled/);
+    });
+  });
+
   describe('getAppMetrics() API', () => {
     it('returns memory and cpu stats of all running electron processes', () => {
       const appMetrics = app.getAppMetrics();
@@ -1199,6 +1262,119 @@ describe('app module', () => {
 
       expect(types).to.include('Browser');
     });
+
+    ifit(process.platform === 'linux')('returns proportional memory stats on Linux', async () => {
+      // Each call schedules a fresh sample for the next one, so poll until the
+      // first sample of the browser process has completed.
+      let browser = app.getAppMetrics().find(entry => entry.type === 'Browser')!;
+      for (let i = 0; i < 50 && !browser.memory; i++) {
+        await delay(100);
+        browser = app.getAppMetrics().find(entry => entry.type === 'Browser')!;
+      }
+      expect(browser.memory).to.be.an('object');
+      expect(browser.memory).to.have.property('swap').that.is.a('number');
+      if (fs.existsSync('/proc/self/smaps_rollup')) {
+        expect(browser.memory).to.have.property('proportionalSetSize').that.is.greaterThan(0);
+        expect(browser.memory.peakProportionalSetSize).to.be.at.least(browser.memory.proportionalSetSize!);
+        expect(browser.memory).to.have.property('privateDirty').that.is.greaterThan(0);
+        expect(browser.memory).to.have.property('sharedDirty').that.is.a('number');
+      } else {
+        expect(browser.memory).to.not.have.property('proportionalSetSize');
+        expect(browser.memory).to.not.have.property('privateDirty');
+      }
+    });
+  });
+
+  describe('startMetricsSampler() API', () => {
+    afterEach(() => {
+      app.stopMetricsSampler();
+    });
+
+    it('returns null when the sampler is not running', () => {
+      expect(app.getMetricsHistory()).to.be.null();
+    });
+
+    it('keeps a bounded history of samples', async () => {
+      app.startMetricsSampler({ interval: 50, historySize: 3 });
+      await delay(500);
+      const history = app.getMetricsHistory()!;
+      expect(history.timestamps).to.be.an.instanceOf(Float64Array).with.lengthOf(3);
+      expect(history.timestamps[2]).to.be.greaterThan(history.timestamps[0]);
+
+      const browser = history.processes.find(p => p.type === 'Browser')!;
+      expect(browser.pid).to.equal(process.pid);
+      for (const key of ['cpuUsage', 'idleWakeupsPerSecond', 'workingSetSize', 'handleCount'] as const) {
+        expect(browser[key]).to.be.an.instanceOf(Float64Array).with.lengthOf(3);
+      }
+      expect(browser.workingSetSize[2]).to.be.greaterThan(0);
+    });
+
+    it('validates its options', () => {
+      expect(() => app.startMetricsSampler({ interval: 0 })).to.throw(/interval must be positive/);
+      expect(() => app.startMetricsSampler({ historySize: -1 })).to.throw(/historySize must be positive/);
+    });
+  });
+
+  describe('startCpuProfiling() API', () => {
+    afterEach(() => {
+      app.stopCpuProfiling();
+    });
+
+    it('returns null when profiling was not started', () => {
+      expect(app.stopCpuProfiling()).to.be.null();
+    });
+
+    it('returns a .cpuprofile', async () => {
+      app.startCpuProfiling({ samplingInterval: 100 });
+      expect(() => app.startCpuProfiling()).to.throw(/already been started/);
+      const end = Date.now() + 100;
+      while (Date.now() < end);
+      const profile = JSON.parse(app.stopCpuProfiling()!);
+      expect(profile.nodes).to.be.an('array').that.is.not.empty();
+      expect(profile.nodes[0].callFrame.functionName).to.equal('(root)');
+      expect(profile.samples).to.be.an('array').that.is.not.empty();
+      expect(profile.timeDeltas).to.have.lengthOf(profile.samples.length);
+      expect(profile.endTime).to.be.at.least(profile.startTime);
+    });
+
+    it('validates its options', () => {
+      expect(() => app.startCpuProfiling({ samplingInterval: 0 })).to.throw(/samplingInterval must be positive/);
+    });
+  });
+
+  describe('startHeapProfiling() API', () => {
+    afterEach(() => {
+      app.stopHeapProfiling();
+    });
+
+    it('returns null when profiling was not started', () => {
+      expect(app.stopHeapProfiling()).to.be.null();
+    });
+
+    it('returns a .heapprofile', () => {
+      app.startHeapProfiling({ samplingInterval: 1024 });
+      expect(() => app.startHeapProfiling()).to.throw(/already been started/);
+      const retained = Array.from({ length: 10000 }, (_, i) => ({ i }));
+      const profile = JSON.parse(app.stopHeapProfiling()!);
+      expect(retained).to.have.lengthOf(10000);
+      expect(profile.head).to.have.property('callFrame');
+      expect(profile.head.children).to.be.an('array');
+      expect(profile.samples).to.be.an('array').that.is.not.empty();
+    });
+
+    it('serializes allocations at the maximum stack depth', () => {
+      app.startHeapProfiling({ samplingInterval: 1024, stackDepth: 96 });
+      const allocate = (depth: number): any[] => depth === 0 ? Array.from({ length: 10000 }, (_, i) => ({ i })) : allocate(depth - 1);
+      const retained = allocate(150);
+      const profile = JSON.parse(app.stopHeapProfiling()!);
+      expect(retained).to.have.lengthOf(10000);
+      expect(profile.samples).to.be.an('array').that.is.not.empty();
+    });
+
+    it('validates its options', () => {
+      expect(() => app.startHeapProfiling({ samplingInterval: 0 })).to.throw(/samplingInterval must be positive/);
+      expect(() => app.startHeapProfiling({ stackDepth: 1000 })).to.throw(/stackDepth must be between 1 and 96/);
+    });
   });
 
   describe('getGPUFeatureStatus() API', () => {
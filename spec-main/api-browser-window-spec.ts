@@ -1562,6 +1562,20 @@ describe('BrowserWindow module', () => {
     });
   });
 
+  describe('BrowserWindow.getAllWindows()', () => {
+    afterEach(closeAllWindows);
+
+    it('tracks windows created after others were closed', async () => {
+      const windows = [1, 2, 3].map(() => new BrowserWindow({ show: false }));
+      await closeWindow(windows[1], { assertNotWindows: false });
+      const w = new BrowserWindow({ show: false });
+      const ids = BrowserWindow.getAllWindows().map(win => win.id).sort();
+      expect(ids).to.deep.equal([windows[0].id, windows[2].id, w.id].sort());
+      expect(BrowserWindow.fromId(w.id)).to.equal(w);
+      expect(BrowserWindow.fromId(windows[1].id)).to.be.null();
+    });
+  });
+
   describe('BrowserWindow.fromWebContents(webContents)', () => {
     afterEach(closeAllWindows);
 
@@ -2036,6 +2050,32 @@ describe('BrowserWindow module', () => {
       });
     });
 
+    describe('"reuseNodeIsolateData" option', () => {
+      it('reports context creation metrics', async () => {
+        const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } });
+        await w.loadFile(path.join(fixtures, 'api', 'blank.html'));
+        const metrics = await w.webContents.executeJavaScript('process.contextCreationMetrics');
+        expect(metrics.createTime).to.be.a('number');
+        expect(metrics.loadTime).to.be.a('number');
+        expect(metrics.isolateDataReused).to.be.false();
+      });
+
+      it('reuses the isolate data after a reload', async () => {
+        const w = new BrowserWindow({
+          show: false,
+          webPreferences: {
+            nodeIntegration: true,
+            reuseNodeIsolateData: true
+          }
+        });
+        await w.loadFile(path.join(fixtures, 'api', 'blank.html'));
+        expect(await w.webContents.executeJavaScript('process.contextCreationMetrics.isolateDataReused')).to.be.false();
+        w.webContents.reload();
+        await emittedOnce(w.webContents, 'did-finish-load');
+        expect(await w.webContents.executeJavaScript('process.contextCreationMetrics.isolateDataReused')).to.be.true();
+      });
+    });
+
     ifdescribe(features.isRemoteModuleEnabled())('"enableRemoteModule" option', () => {
       const generateSpecs = (description: string, sandbox: boolean) => {
         describe(description, () => {
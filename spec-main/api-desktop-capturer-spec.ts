@@ -95,6 +95,27 @@ ifdescribe(!process.arch.includes('arm') && process.platform !== 'win32')('deskt
     expect(sources).to.be.empty();
   });
 
+  describe('streamSources()', () => {
+    it('throws an error for an invalid listener', async () => {
+      await expect((desktopCapturer as any).streamSources({ types: ['screen'] }, null)).to.eventually.be.rejectedWith(Error, 'listener must be a function');
+    });
+
+    // Linux doesn't return any window sources.
+    ifit(process.platform !== 'linux')('emits every source exactly once', async () => {
+      const w2 = new BrowserWindow({ width: 200, height: 200 });
+      await w2.loadURL('about:blank');
+
+      const streamed: Electron.DesktopCapturerSource[] = [];
+      const sources = await desktopCapturer.streamSources({ types: ['window', 'screen'] }, (source) => {
+        streamed.push(source);
+      });
+      w2.destroy();
+
+      expect(sources).to.be.an('array').that.is.not.empty();
+      expect(streamed.map(s => s.id).sort()).to.deep.equal(sources.map(s => s.id).sort());
+    });
+  });
+
   it('disabling thumbnail should return empty images', async () => {
     const w2 = new BrowserWindow({ show: false, width: 200, height: 200 });
     const wShown = emittedOnce(w2, 'show');
@@ -1,10 +1,13 @@
 import { expect } from 'chai';
 import { net, session, ClientRequest, BrowserWindow } from 'electron/main';
+import * as fs from 'fs';
 import * as http from 'http';
+import * as os from 'os';
+import * as path from 'path';
 import * as url from 'url';
 import { AddressInfo, Socket } from 'net';
 import { emittedOnce } from './events-helpers';
-import { defer } from './spec-helpers';
+import { defer, delay } from './spec-helpers';
 
 const kOneKiloByte = 1024;
 const kOneMegaByte = kOneKiloByte * kOneKiloByte;
@@ -176,6 +179,44 @@ describe('net module', () => {
       expect(response.statusCode).to.equal(200);
     });
 
+    it('should coalesce response data into chunks of responseBufferSize', async () => {
+      const bodyData = randomBuffer(kOneMegaByte);
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end(bodyData);
+      });
+      const responseBufferSize = 64 * kOneKiloByte;
+      const urlRequest = net.request({ url: serverUrl, responseBufferSize });
+      const response = await getResponse(urlRequest);
+      const chunks: Buffer[] = [];
+      response.on('data', (chunk) => chunks.push(chunk));
+      await emittedOnce(response, 'end');
+      for (const chunk of chunks.slice(0, -1)) {
+        expect(chunk.length).to.equal(responseBufferSize);
+      }
+      expect(Buffer.concat(chunks).equals(bodyData)).to.equal(true);
+    });
+
+    it('should reject a responseBufferSize above the maximum', () => {
+      expect(() => {
+        net.request({ url: 'http://127.0.0.1', responseBufferSize: 2 ** 31 - 1 });
+      }).to.throw(/responseBufferSize/);
+    });
+
+    it('should write the response to savePath', async () => {
+      const bodyData = randomBuffer(kOneMegaByte);
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end(bodyData);
+      });
+      const savePath = path.join(os.tmpdir(), `electron-net-spec-${process.pid}`);
+      defer(() => fs.promises.unlink(savePath).catch(() => {}));
+      const urlRequest = net.request({ url: serverUrl, savePath });
+      const response = await getResponse(urlRequest);
+      expect(response.statusCode).to.equal(200);
+      const body = await collectStreamBodyBuffer(response);
+      expect(body.length).to.equal(0);
+      expect((await fs.promises.readFile(savePath)).equals(bodyData)).to.equal(true);
+    });
+
     it('should support chunked encoding', async () => {
       const serverUrl = await respondOnce.toSingleURL((request, response) => {
         response.statusCode = 200;
@@ -1075,6 +1116,31 @@ describe('net module', () => {
       await emittedOnce(urlRequest, 'abort');
     });
 
+    it('should not send the redirected request when a redirect handler aborts', async () => {
+      let redirected = false;
+      const serverUrl = await respondOnce.toRoutes({
+        '/302': (request, response) => {
+          response.statusCode = 302;
+          response.setHeader('Location', '/200');
+          response.end();
+        },
+        '/200': (request, response) => {
+          redirected = true;
+          response.statusCode = 200;
+          response.end();
+        }
+      });
+      const urlRequest = net.request({
+        url: `${serverUrl}/302`
+      });
+      urlRequest.on('redirect', () => { urlRequest.abort(); });
+      urlRequest.on('error', () => {});
+      urlRequest.end();
+      await emittedOnce(urlRequest, 'abort');
+      await delay(100);
+      expect(redirected).to.be.false();
+    });
+
     it('should not follow redirect when mode is error', async () => {
       const serverUrl = await respondOnce.toSingleURL((request, response) => {
         response.statusCode = 302;
@@ -1089,6 +1155,56 @@ describe('net module', () => {
       await emittedOnce(urlRequest, 'error');
     });
 
+    it('should not send the redirected request when mode is error', async () => {
+      let redirected = false;
+      const serverUrl = await respondOnce.toRoutes({
+        '/302': (request, response) => {
+          response.statusCode = 302;
+          response.setHeader('Location', '/200');
+          response.end();
+        },
+        '/200': (request, response) => {
+          redirected = true;
+          response.statusCode = 200;
+          response.end();
+        }
+      });
+      const urlRequest = net.request({
+        url: `${serverUrl}/302`,
+        redirect: 'error'
+      });
+      urlRequest.end();
+      await emittedOnce(urlRequest, 'error');
+      expect(redirected).to.be.false();
+    });
+
+    it('should not send the redirected request when a manual redirect is cancelled', async () => {
+      let redirected = false;
+      const serverUrl = await respondOnce.toRoutes({
+        '/302': (request, response) => {
+          response.statusCode = 302;
+          response.setHeader('Location', '/200');
+          response.end();
+        },
+        '/200': (request, response) => {
+          redirected = true;
+          response.statusCode = 200;
+          response.end();
+        }
+      });
+      const urlRequest = net.request({
+        url: `${serverUrl}/302`,
+        redirect: 'manual'
+      });
+      urlRequest.on('redirect', () => {
+        urlRequest.abort();
+      });
+      urlRequest.end();
+      await emittedOnce(urlRequest, 'abort');
+      await delay(100);
+      expect(redirected).to.be.false();
+    });
+
     it('should follow redirect when handler calls callback', async () => {
       const serverUrl = await respondOnce.toRoutes({
         '/redirectChain': (request, response) => {
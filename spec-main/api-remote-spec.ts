@@ -980,6 +980,45 @@ ifdescribe(features.isRemoteModuleEnabled())('remote module', () => {
       expect(Object.getPrototypeOf(proto)).to.have.ownProperty('method');
     });
 
+    it('sees members added to a prototype after it was described', async () => {
+      const classPath = path.join(fixtures, 'module', 'class.js');
+      expect(await remotely((classPath: string) => {
+        const { derived } = require('electron').remote.require(classPath);
+        return typeof derived.method;
+      }, classPath)).to.equal('function');
+
+      const proto = Object.getPrototypeOf(Object.getPrototypeOf(require(classPath).derived));
+      proto.added = function () { return 'added'; };
+      try {
+        expect(await remotely((classPath: string) => {
+          const { derived } = require('electron').remote.require(classPath);
+          return derived.added();
+        }, classPath)).to.equal('added');
+      } finally {
+        delete proto.added;
+      }
+    });
+
+    it('sees members of a prototype replaced after it was described', async () => {
+      const classPath = path.join(fixtures, 'module', 'class.js');
+      expect(await remotely((classPath: string) => {
+        const { derived } = require('electron').remote.require(classPath);
+        return typeof derived.method;
+      }, classPath)).to.equal('function');
+
+      const proto = Object.getPrototypeOf(Object.getPrototypeOf(require(classPath).derived));
+      const original = Object.getOwnPropertyDescriptor(proto, 'method')!;
+      Object.defineProperty(proto, 'method', { get: () => 'replaced', configurable: true });
+      try {
+        expect(await remotely((classPath: string) => {
+          const { derived } = require('electron').remote.require(classPath);
+          return derived.method;
+        }, classPath)).to.equal('replaced');
+      } finally {
+        Object.defineProperty(proto, 'method', original);
+      }
+    });
+
     remotely.it(fixtures)('is referenced by methods in prototype chain', (fixtures: string) => {
       let { derived } = require('electron').remote.require(require('path').join(fixtures, 'module', 'class.js'));
       const method = derived.method;
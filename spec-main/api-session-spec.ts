@@ -121,6 +121,113 @@ describe('session module', () => {
       expect(cs.some(c => c.name === name && c.value === value)).to.equal(true);
     });
 
+    it('filters cookies by domain, secure and session', async () => {
+      const { cookies } = session.defaultSession;
+      await cookies.set({ url: 'https://a.example.com', name: 'a', value: '1', secure: true });
+      await cookies.set({ url: 'https://b.example.com', name: 'b', value: '1', expirationDate: (+new Date()) / 1000 + 120 });
+      await cookies.set({ url: 'https://notexample.com', name: 'c', value: '1' });
+      try {
+        const names = async (filter: Electron.CookiesGetFilter) => (await cookies.get(filter)).map(c => c.name).sort();
+        expect(await names({ domain: 'example.com' })).to.deep.equal(['a', 'b']);
+        expect(await names({ domain: '.example.com' })).to.deep.equal(['a', 'b']);
+        expect(await names({ domain: 'example.com', secure: true })).to.deep.equal(['a']);
+        expect(await names({ domain: 'example.com', session: false })).to.deep.equal(['b']);
+      } finally {
+        await cookies.remove('https://a.example.com', 'a');
+        await cookies.remove('https://b.example.com', 'b');
+        await cookies.remove('https://notexample.com', 'c');
+      }
+    });
+
+    it('pages through matching cookies with offset and limit', async () => {
+      const { cookies } = session.defaultSession;
+      for (const name of ['p1', 'p2', 'p3']) {
+        await cookies.set({ url, name, value: name });
+      }
+      const all = (await cookies.get({ url })).map(c => c.name);
+      const page1 = (await cookies.get({ url, limit: 2 })).map(c => c.name);
+      const page2 = (await cookies.get({ url, offset: 2, limit: 2 })).map(c => c.name);
+      expect(page1).to.deep.equal(all.slice(0, 2));
+      expect(page2).to.deep.equal(all.slice(2, 4));
+      await expect(cookies.get({ url, limit: -1 })).to.eventually.be.rejectedWith('limit must not be negative');
+    });
+
+    it('sets and removes many cookies at once', async () => {
+      const { cookies } = session.defaultSession;
+      const results = await cookies.setMany([
+        { url, name: 'm1', value: '1' },
+        { url, name: 'm2', value: '2', sameSite: 'garbage' as any },
+        { url, name: 'm3', value: '3' }
+      ]);
+      expect(results.map(r => r.success)).to.deep.equal([true, false, true]);
+      expect(results[1].error).to.equal('Failed to convert \'garbage\' to an appropriate cookie same site value');
+      expect((await cookies.get({ url })).map(c => c.name).sort()).to.deep.equal(['m1', 'm3']);
+
+      const removed = await cookies.removeMany([{ url, name: 'm1' }, { url, name: 'm3' }]);
+      expect(removed.map(r => r.success)).to.deep.equal([true, true]);
+      expect(await cookies.get({ url })).to.be.empty();
+    });
+
+    it('restores cookies saved with cookies.get()', async () => {
+      const { cookies } = session.defaultSession;
+      await cookies.set({ url, name: 'saved', value: '1', expirationDate: (+new Date()) / 1000 + 120 });
+      const jar = JSON.parse(JSON.stringify(await cookies.get({ url })));
+      await cookies.remove(url, 'saved');
+
+      const results = await cookies.setMany(jar);
+      expect(results.every(r => r.success)).to.be.true();
+      const [restored] = await cookies.get({ url, name: 'saved' });
+      expect(restored).to.deep.equal(jar[0]);
+    });
+
+    describe('cookies.setChangeNotificationOptions()', () => {
+      afterEach(() => {
+        session.defaultSession.cookies.setChangeNotificationOptions({});
+      });
+
+      it('batches changes into a single changed-batch event', async () => {
+        const { cookies } = session.defaultSession;
+        cookies.setChangeNotificationOptions({ batchInterval: 50 });
+        const changed = () => { throw new Error('Unexpected changed event'); };
+        cookies.on('changed', changed);
+        try {
+          const batch = emittedOnce(cookies, 'changed-batch');
+          await cookies.setMany([
+            { url, name: 'b1', value: '1' },
+            { url, name: 'b2', value: '2' }
+          ]);
+          const [, changes] = await batch;
+          expect(changes.map((c: any) => c.cookie.name)).to.deep.equal(['b1', 'b2']);
+          expect(changes.every((c: any) => c.cause === 'explicit' && !c.removed)).to.be.true();
+        } finally {
+          cookies.removeListener('changed', changed);
+        }
+      });
+
+      it('drops changes not matching the filter', async () => {
+        const { cookies } = session.defaultSession;
+        cookies.setChangeNotificationOptions({ name: 'wanted' });
+        const names: string[] = [];
+        const changed = (event: any, cookie: Electron.Cookie) => { names.push(cookie.name); };
+        cookies.on('changed', changed);
+        try {
+          const wanted = emittedOnce(cookies, 'changed');
+          await cookies.set({ url, name: 'unwanted', value: '1' });
+          await cookies.set({ url, name: 'wanted', value: '1' });
+          await wanted;
+          expect(names).to.deep.equal(['wanted']);
+        } finally {
+          cookies.removeListener('changed', changed);
+        }
+      });
+
+      it('rejects a negative batchInterval', () => {
+        expect(() => {
+          session.defaultSession.cookies.setChangeNotificationOptions({ batchInterval: -1 });
+        }).to.throw('batchInterval must not be negative');
+      });
+    });
+
     it('yields an error when setting a cookie with missing required fields', async () => {
       const { cookies } = session.defaultSession;
       const name = '1';
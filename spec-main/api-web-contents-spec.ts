@@ -3,6 +3,7 @@ import { AddressInfo } from 'net';
 import * as path from 'path';
 import * as fs from 'fs';
 import * as http from 'http';
+import * as zlib from 'zlib';
 import * as ChildProcess from 'child_process';
 import { BrowserWindow, ipcMain, webContents, session, WebContents, app } from 'electron/main';
 import { clipboard } from 'electron/common';
@@ -421,6 +422,51 @@ describe('webContents module', () => {
     });
   });
 
+  describe('capturePages() API', () => {
+    afterEach(closeAllWindows);
+
+    it('resolves with an empty array for no requests', async () => {
+      const results = await webContents.capturePages([]);
+      expect(results).to.deep.equal([]);
+    });
+
+    it('rejects requests without a webContents', async () => {
+      await expect(webContents.capturePages([{} as any])).to.eventually.be.rejectedWith(/webContents/);
+    });
+
+    it('rejects an invalid encoding', async () => {
+      const w = new BrowserWindow({ show: false });
+      await expect(webContents.capturePages([{ webContents: w.webContents, encoding: 'gif' as any }])).to.eventually.be.rejectedWith(/Invalid encoding/);
+    });
+
+    it('captures several pages at the requested scale', async () => {
+      const w1 = new BrowserWindow({ show: true, width: 200, height: 200 });
+      const w2 = new BrowserWindow({ show: true, width: 200, height: 200 });
+      await Promise.all([
+        w1.loadFile(path.join(fixturesPath, 'pages', 'base-page.html')),
+        w2.loadFile(path.join(fixturesPath, 'pages', 'base-page.html'))
+      ]);
+
+      const rect = { x: 0, y: 0, width: 100, height: 100 };
+      const results = await webContents.capturePages([
+        { webContents: w1.webContents, rect, scaleFactor: 0.5 },
+        { webContents: w2.webContents, rect, scaleFactor: 0.5, encoding: 'png' }
+      ]);
+
+      expect(results).to.have.length(2);
+      expect(results[0].image!.getSize()).to.deep.equal({ width: 50, height: 50 });
+      expect(results[0].size).to.deep.equal({ width: 50, height: 50 });
+      expect(results[0].captureTime).to.be.a('number');
+      expect(results[0].encodeTime).to.equal(0);
+
+      expect(results[1].image).to.be.undefined();
+      expect(results[1].data).to.be.an.instanceOf(Buffer);
+      // PNG signature.
+      expect(results[1].data!.slice(1, 4).toString()).to.equal('PNG');
+      expect(results[1].size).to.deep.equal({ width: 50, height: 50 });
+    });
+  });
+
   describe('setDevToolsWebContents() API', () => {
     afterEach(closeAllWindows);
     it('sets arbitrary webContents as devtools', async () => {
@@ -1512,6 +1558,123 @@ describe('webContents module', () => {
     generateSpecs('with sandbox', true);
   });
 
+  describe('preload-executed event', () => {
+    const preload = path.join(app.getPath('temp'), `preload-executed-${process.pid}.js`);
+    afterEach(closeAllWindows);
+    afterEach(() => {
+      try {
+        fs.unlinkSync(preload);
+      } catch (e) {
+        // ignore error
+      }
+    });
+
+    const loadWindow = async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { sandbox: true, preload } });
+      const promise = emittedOnce(w.webContents, 'preload-executed');
+      w.loadURL('about:blank');
+      const [, preloadPath, details] = await promise;
+      expect(preloadPath).to.equal(preload);
+      return details;
+    };
+
+    it('reports timings of sandboxed preload scripts', async () => {
+      fs.writeFileSync(preload, 'window.foo = 1;');
+      const details = await loadWindow();
+      expect(details.compileTime).to.be.a('number').that.is.at.least(0);
+      expect(details.executionTime).to.be.a('number').that.is.at.least(0);
+      expect(details.elapsedTime).to.be.at.least(details.compileTime + details.executionTime);
+    });
+
+    // The browser only hands out code caches to renderers whose V8 flags
+    // match its own, so whether one is used depends on the configuration,
+    // but a cache it hands out must never be rejected.
+    it('never hands out a code cache the renderer rejects', async () => {
+      fs.writeFileSync(preload, 'window.foo = 2;');
+      expect((await loadWindow()).codeCache).to.equal('none');
+      for (let i = 0; i < 3; i++) {
+        await delay(100);
+        expect((await loadWindow()).codeCache).to.be.oneOf(['none', 'accepted']);
+      }
+    });
+
+    it('invalidates the code cache when the script changes', async () => {
+      fs.writeFileSync(preload, 'window.foo = 3;');
+      await loadWindow();
+      await delay(100);
+      await loadWindow();
+      fs.writeFileSync(preload, 'window.foo = 3; window.bar = 4;');
+      expect((await loadWindow()).codeCache).to.equal('none');
+    });
+  });
+
+  describe('getResourceUsage()', () => {
+    afterEach(closeAllWindows);
+
+    it('attributes heap and network usage to the page', async () => {
+      const server = http.createServer((req, res) => {
+        res.setHeader('Content-Type', 'text/html');
+        res.end(req.url === '/' ? '<script src="/script.js"></script>' : 'window.loaded = true');
+      });
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+      defer(() => { server.close(); });
+      const { port } = server.address() as AddressInfo;
+
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL(`http://127.0.0.1:${port}/`);
+      const usage = await w.webContents.getResourceUsage();
+      expect(usage.pid).to.equal(w.webContents.getOSProcessId());
+      expect(usage.sharedViewCount).to.be.at.least(1);
+      expect(usage.jsHeap.usedSize).to.be.greaterThan(0);
+      expect(usage.jsHeap.totalSize).to.be.at.least(usage.jsHeap.usedSize);
+      expect(usage.blinkCacheSize).to.be.a('number');
+      expect(usage.network.requestCount).to.be.at.least(1);
+      expect(usage.network.bytesReceived).to.be.greaterThan(0);
+    });
+  });
+
+  describe('startCpuProfiling()', () => {
+    afterEach(closeAllWindows);
+
+    it('returns a .cpuprofile of the renderer', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.startCpuProfiling({ samplingInterval: 100 });
+      await expect(w.webContents.startCpuProfiling()).to.eventually.be.rejectedWith(/already been started/);
+      await w.webContents.executeJavaScript('const end = Date.now() + 100; while (Date.now() < end);');
+      const profile = JSON.parse(await w.webContents.stopCpuProfiling());
+      expect(profile.nodes).to.be.an('array').that.is.not.empty();
+      expect(profile.samples).to.be.an('array').that.is.not.empty();
+      expect(profile.timeDeltas).to.have.lengthOf(profile.samples.length);
+    });
+
+    it('rejects stopping when profiling was not started', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await expect(w.webContents.stopCpuProfiling()).to.eventually.be.rejectedWith(/has not been started/);
+    });
+  });
+
+  describe('startHeapProfiling()', () => {
+    afterEach(closeAllWindows);
+
+    it('returns a .heapprofile of the renderer', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.startHeapProfiling({ samplingInterval: 1024, stackDepth: 8 });
+      await w.webContents.executeJavaScript('window.retained = Array.from({ length: 10000 }, (_, i) => ({ i }))');
+      const profile = JSON.parse(await w.webContents.stopHeapProfiling());
+      expect(profile.head).to.have.property('callFrame');
+      expect(profile.samples).to.be.an('array').that.is.not.empty();
+    });
+
+    it('validates its options', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await expect(w.webContents.startHeapProfiling({ stackDepth: 0 })).to.eventually.be.rejectedWith(/stackDepth must be between 1 and 96/);
+    });
+  });
+
   describe('takeHeapSnapshot()', () => {
     afterEach(closeAllWindows);
 
@@ -1557,6 +1720,53 @@ describe('webContents module', () => {
       const promise = w.webContents.takeHeapSnapshot('');
       return expect(promise).to.be.eventually.rejectedWith(Error, 'takeHeapSnapshot failed');
     });
+
+    it('gzips the snapshot and reports progress', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+
+      const filePath = path.join(app.getPath('temp'), 'test.heapsnapshot.gz');
+      const progress: number[][] = [];
+      try {
+        await w.webContents.takeHeapSnapshot(filePath, {
+          compress: true,
+          onProgress: (done, total) => progress.push([done, total])
+        });
+        const snapshot = JSON.parse(zlib.gunzipSync(fs.readFileSync(filePath)).toString());
+        expect(snapshot).to.have.property('nodes');
+        expect(progress).to.not.be.empty();
+        for (const [done, total] of progress) {
+          expect(done).to.be.at.most(total);
+        }
+      } finally {
+        fs.unlinkSync(filePath);
+      }
+    });
+  });
+
+  describe('streamHeapSnapshot()', () => {
+    afterEach(closeAllWindows);
+
+    it('passes the snapshot in chunks', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+
+      const chunks: Buffer[] = [];
+      await w.webContents.streamHeapSnapshot(chunk => chunks.push(chunk));
+      expect(chunks.length).to.be.greaterThan(1);
+      const snapshot = JSON.parse(Buffer.concat(chunks).toString());
+      expect(snapshot).to.have.property('nodes');
+    });
+
+    it('can gzip the chunks', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+
+      const chunks: Buffer[] = [];
+      await w.webContents.streamHeapSnapshot(chunk => chunks.push(chunk), { compress: true });
+      const snapshot = JSON.parse(zlib.gunzipSync(Buffer.concat(chunks)).toString());
+      expect(snapshot).to.have.property('nodes');
+    });
   });
 
   describe('setBackgroundThrottling()', () => {
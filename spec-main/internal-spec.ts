@@ -1,4 +1,9 @@
 import { expect } from 'chai';
+import { app, BrowserWindow } from 'electron/main';
+import * as fs from 'fs';
+import * as path from 'path';
+import { delay } from './spec-helpers';
+import { closeAllWindows } from './window-helpers';
 
 describe('feature-string parsing', () => {
   it('is indifferent to whitespace around keys and values', () => {
@@ -19,3 +24,23 @@ describe('feature-string parsing', () => {
     checkParse(' a = yes , c = d ', { a: true, c: 'd' });
   });
 });
+
+describe('bundle code cache', () => {
+  const cachePath = path.join(app.getPath('userData'), 'BundleCodeCache');
+
+  afterEach(closeAllWindows);
+
+  it('is stored in userData once a renderer launches', async () => {
+    const w = new BrowserWindow({ show: false, webPreferences: { sandbox: true } });
+    await w.loadURL('about:blank');
+    while (!fs.existsSync(cachePath)) await delay(50);
+    expect(fs.statSync(cachePath).size).to.be.above(0);
+  });
+
+  it('initializes renderers launched with the cache', async () => {
+    while (!fs.existsSync(cachePath)) await delay(50);
+    const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+    await w.loadURL('about:blank');
+    expect(await w.webContents.executeJavaScript('typeof require')).to.equal('function');
+  });
+});
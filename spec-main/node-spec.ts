@@ -1,5 +1,7 @@
 import { expect } from 'chai';
 import * as childProcess from 'child_process';
+import * as fs from 'fs';
+import * as os from 'os';
 import * as path from 'path';
 import * as util from 'util';
 import { emittedOnce } from './events-helpers';
@@ -313,6 +315,120 @@ describe('node feature', () => {
     child.kill();
   });
 
+  ifit(process.platform === 'linux')('runs timers and I/O with --enable-uv-glib-integration', async () => {
+    const scriptPath = path.join(fixtures, 'api', 'uv-glib-integration.js');
+    const child = childProcess.spawn(process.execPath, ['--enable-uv-glib-integration', scriptPath]);
+    let output = '';
+    child.stdout.on('data', (data) => { output += data; });
+    const [code] = await emittedOnce(child, 'exit');
+    expect(code).to.equal(0);
+    expect(output).to.equal('pong');
+  });
+
+  ifit(process.platform === 'linux')('sees sockets opened from uv callbacks with --enable-uv-glib-integration', async () => {
+    const scriptPath = path.join(fixtures, 'api', 'uv-glib-integration-watcher.js');
+    const child = childProcess.spawn(process.execPath, ['--enable-uv-glib-integration', scriptPath]);
+    let output = '';
+    child.stdout.on('data', (data) => { output += data; });
+    const [code] = await emittedOnce(child, 'exit');
+    expect(code).to.equal(0);
+    expect(output).to.equal('pong');
+  });
+
+  describe('browser_v8_snapshot.bin', () => {
+    const appFixture = path.join(fixtures, 'api', 'browser-snapshot');
+    // The directory mksnapshot and its arguments are unpacked to.
+    const buildDir = process.platform === 'darwin'
+      ? path.resolve(process.execPath, '..', '..', '..', '..')
+      : path.dirname(process.execPath);
+    let appDir: string;
+    let appExecPath: string;
+    let snapshotPath: string;
+
+    // The snapshot is looked up next to the executable, so the specs run a
+    // copy of the app instead of writing into the one being tested.
+    before(async function () {
+      this.timeout(120000);
+      appDir = await fs.promises.mkdtemp(path.join(os.tmpdir(), 'electron-snapshot-spec-'));
+      if (process.platform === 'darwin') {
+        const bundle = path.resolve(process.execPath, '..', '..', '..');
+        childProcess.execFileSync('cp', ['-R', bundle, appDir]);
+        const appBundle = path.join(appDir, path.basename(bundle));
+        appExecPath = path.join(appBundle, 'Contents', 'MacOS', path.basename(process.execPath));
+        snapshotPath = path.join(appBundle, 'Contents', 'Resources', 'browser_v8_snapshot.bin');
+      } else {
+        const platform = process.platform === 'win32' ? 'win' : 'linux';
+        const arch = platform === 'linux' && process.arch === 'ia32' ? 'x86' : process.arch;
+        const manifest = path.join(__dirname, '..', 'script', 'zip_manifests', `dist_zip.${platform}.${arch}.manifest`);
+        for (const file of fs.readFileSync(manifest, 'utf8').split(/\r?\n/)) {
+          // A copied chrome-sandbox loses its setuid bit, the copy runs
+          // with --no-sandbox instead.
+          const source = path.join(buildDir, file);
+          if (!file || file.endsWith('/') || file === 'chrome-sandbox' || !fs.existsSync(source)) continue;
+          const target = path.join(appDir, file);
+          fs.mkdirSync(path.dirname(target), { recursive: true });
+          fs.copyFileSync(source, target);
+        }
+        appExecPath = path.join(appDir, path.basename(process.execPath));
+        snapshotPath = path.join(appDir, 'resources', 'browser_v8_snapshot.bin');
+      }
+    });
+
+    after(() => {
+      if (appDir) fs.rmdirSync(appDir, { recursive: true });
+    });
+
+    afterEach(() => {
+      try {
+        fs.unlinkSync(snapshotPath);
+      } catch (e) {
+        // ignore error
+      }
+    });
+
+    const launch = async () => {
+      const args = process.platform === 'linux' ? ['--no-sandbox', appFixture] : [appFixture];
+      const child = childProcess.spawn(appExecPath, args);
+      let output = '';
+      child.stdout.on('data', (data) => { output += data; });
+      const [code] = await emittedOnce(child, 'exit');
+      expect(code).to.equal(0);
+      return output.trim();
+    };
+
+    it('falls back to the default snapshot when the file is invalid', async () => {
+      fs.writeFileSync(snapshotPath, 'not a snapshot');
+      expect(await launch()).to.equal('undefined');
+    });
+
+    it('starts the main process from the snapshot', async function () {
+      // mksnapshot_args only exists where mksnapshot was unpacked next to
+      // the build, like on CI.
+      const argsPath = path.join(buildDir, 'mksnapshot_args');
+      if (!fs.existsSync(argsPath)) {
+        this.skip();
+      }
+      this.timeout(120000);
+
+      // Build the snapshot like verify-mksnapshot.py does, but into the copy
+      // of the app and without touching the build's embedded builtins.
+      const [mksnapshot, ...args] = fs.readFileSync(argsPath, 'utf8').split(/\r?\n/).filter(arg => arg);
+      const setArg = (name: string, value: string) => {
+        const index = args.indexOf(name);
+        if (index === -1) {
+          args.push(name, value);
+        } else {
+          args[index + 1] = value;
+        }
+      };
+      setArg('--startup_blob', snapshotPath);
+      setArg('--embedded_src', path.join(appDir, 'embedded.S'));
+      childProcess.execFileSync(path.resolve(buildDir, mksnapshot), [...args, path.join(appFixture, 'snapshot.js')], { cwd: buildDir });
+
+      expect(await launch()).to.equal('loaded from snapshot');
+    });
+  });
+
   it('performs microtask checkpoint correctly', (done) => {
     const f3 = async () => {
       return new Promise((resolve, reject) => {
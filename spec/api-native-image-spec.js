@@ -183,6 +183,47 @@ describe('nativeImage module', () => {
       expect(() => nativeImage.createFromBitmap(Buffer.from([]), {})).to.throw('width is required');
       expect(() => nativeImage.createFromBitmap(Buffer.from([]), { width: 1 })).to.throw('height is required');
       expect(() => nativeImage.createFromBitmap(Buffer.from([]), { width: 1, height: 1 })).to.throw('invalid buffer size');
+      expect(() => nativeImage.createFromBitmap(Buffer.alloc(4), { width: 1, height: 1, format: 'argb' })).to.throw(/format must be one of/);
+      expect(() => nativeImage.createFromBitmap(Buffer.alloc(4), { width: 1, height: 1, alphaType: 'straight' })).to.throw(/alphaType must be one of/);
+    });
+
+    it('accepts rgba and unpremultiplied pixel data', () => {
+      // A half transparent red pixel.
+      const rgba = Buffer.from([255, 0, 0, 128]);
+      const image = nativeImage.createFromBitmap(rgba, { width: 1, height: 1, format: 'rgba', alphaType: 'unpremultiplied' });
+      expect(image.getSize()).to.deep.equal({ width: 1, height: 1 });
+
+      const bgraPremul = image.toBitmap({ format: 'bgra', alphaType: 'premultiplied' });
+      expect([...bgraPremul]).to.deep.equal([0, 0, 128, 128]);
+
+      const roundTrip = image.toBitmap({ format: 'rgba', alphaType: 'unpremultiplied' });
+      expect([...roundTrip]).to.deep.equal([255, 0, 0, 128]);
+    });
+  });
+
+  describe('toBitmap(options)', () => {
+    it('returns the native layout by default', () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      expect(image.toBitmap().equals(image.getBitmap())).to.be.true();
+    });
+
+    it('swizzles between rgba and bgra', () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      const rgba = image.toBitmap({ format: 'rgba' });
+      const bgra = image.toBitmap({ format: 'bgra' });
+      expect(rgba).to.have.lengthOf(538 * 190 * 4);
+      expect(bgra).to.have.lengthOf(538 * 190 * 4);
+      for (let i = 0; i < rgba.length; i += 4) {
+        if (rgba[i] !== bgra[i + 2] || rgba[i + 2] !== bgra[i] ||
+            rgba[i + 1] !== bgra[i + 1] || rgba[i + 3] !== bgra[i + 3]) {
+          expect.fail(`pixel ${i / 4} differs`);
+        }
+      }
+    });
+
+    it('throws on an invalid format', () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      expect(() => image.toBitmap({ format: 'yuv' })).to.throw(/format must be one of/);
     });
   });
 
@@ -389,6 +430,116 @@ describe('nativeImage module', () => {
     });
   });
 
+  describe('decoded image cache', () => {
+    const fs = require('fs');
+    const os = require('os');
+
+    beforeEach(() => {
+      nativeImage.setCacheLimit(32 * 1024 * 1024);
+    });
+
+    afterEach(() => {
+      nativeImage.setCacheLimit(0);
+      nativeImage.purgeCache();
+    });
+
+    it('is disabled by default', () => {
+      nativeImage.setCacheLimit(0);
+      nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      expect(nativeImage.getCacheStats().count).to.equal(0);
+    });
+
+    it('does not count lookups while disabled', () => {
+      nativeImage.setCacheLimit(0);
+      const before = nativeImage.getCacheStats();
+      nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      expect(nativeImage.getCacheStats().misses).to.equal(before.misses);
+    });
+
+    it('serves repeated loads of the same path from the cache', () => {
+      const imagePath = path.join(__dirname, 'fixtures', 'assets', 'logo.png');
+      nativeImage.purgeCache();
+      const before = nativeImage.getCacheStats();
+      const imageA = nativeImage.createFromPath(imagePath);
+      const imageB = nativeImage.createFromPath(imagePath);
+      const after = nativeImage.getCacheStats();
+
+      expect(after.misses - before.misses).to.equal(1);
+      expect(after.hits - before.hits).to.equal(1);
+      expect(after.count).to.equal(1);
+      expect(after.size).to.equal(538 * 190 * 4);
+      expect(imageA.toBitmap().equals(imageB.toBitmap())).to.be.true();
+    });
+
+    it('does not let getBitmap() write to the cached pixels', () => {
+      const imagePath = path.join(__dirname, 'fixtures', 'assets', 'logo.png');
+      const imageA = nativeImage.createFromPath(imagePath);
+      const original = imageA.toBitmap();
+      imageA.getBitmap().fill(0);
+      const imageB = nativeImage.createFromPath(imagePath);
+      expect(imageA.toBitmap().equals(original)).to.be.true();
+      expect(imageB.toBitmap().equals(original)).to.be.true();
+    });
+
+    it('serves createFromPathAsync() from the cache', async () => {
+      const imagePath = path.join(__dirname, 'fixtures', 'assets', 'logo.png');
+      nativeImage.purgeCache();
+      const imageA = nativeImage.createFromPath(imagePath);
+      const before = nativeImage.getCacheStats();
+      const imageB = await nativeImage.createFromPathAsync(imagePath);
+      expect(nativeImage.getCacheStats().hits - before.hits).to.equal(1);
+      expect(imageB.toBitmap().equals(imageA.toBitmap())).to.be.true();
+    });
+
+    it('does not share representations added to a cached image', () => {
+      const imagePath = path.join(__dirname, 'fixtures', 'assets', 'logo.png');
+      const imageA = nativeImage.createFromPath(imagePath);
+      imageA.addRepresentation({ scaleFactor: 2.0, buffer: imageA.toPNG() });
+      const imageB = nativeImage.createFromPath(imagePath);
+      expect(imageA.getScaleFactors()).to.deep.equal([1, 2]);
+      expect(imageB.getScaleFactors()).to.deep.equal([1]);
+    });
+
+    it('invalidates entries when the file changes', () => {
+      const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-image-cache-'));
+      const imagePath = path.join(dir, 'image.png');
+      fs.copyFileSync(path.join(__dirname, 'fixtures', 'assets', 'logo.png'), imagePath);
+      expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 538, height: 190 });
+
+      fs.copyFileSync(path.join(__dirname, 'fixtures', 'assets', '3x3.png'), imagePath);
+      const future = new Date(Date.now() + 10000);
+      fs.utimesSync(imagePath, future, future);
+      expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 3, height: 3 });
+    });
+
+    it('invalidates entries when the file changes without a new modification time', () => {
+      const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-image-cache-'));
+      const imagePath = path.join(dir, 'image.png');
+      fs.copyFileSync(path.join(__dirname, 'fixtures', 'assets', 'logo.png'), imagePath);
+      const { atime, mtime } = fs.statSync(imagePath);
+      expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 538, height: 190 });
+
+      fs.copyFileSync(path.join(__dirname, 'fixtures', 'assets', '3x3.png'), imagePath);
+      fs.utimesSync(imagePath, atime, mtime);
+      expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 3, height: 3 });
+    });
+
+    it('evicts images above the limit', () => {
+      nativeImage.setCacheLimit(0);
+      nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      const stats = nativeImage.getCacheStats();
+      expect(stats.count).to.equal(0);
+      expect(stats.size).to.equal(0);
+      expect(stats.maxSize).to.equal(0);
+    });
+
+    it('purges all the images', () => {
+      nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'));
+      nativeImage.purgeCache();
+      expect(nativeImage.getCacheStats().count).to.equal(0);
+    });
+  });
+
   describe('createFromNamedImage(name)', () => {
     it('returns empty for invalid options', () => {
       const image = nativeImage.createFromNamedImage('totally_not_real');
@@ -446,6 +597,77 @@ describe('nativeImage module', () => {
     });
   });
 
+  describe('async methods', () => {
+    const logoPath = path.join(__dirname, 'fixtures', 'assets', 'logo.png');
+
+    it('createFromPathAsync() matches createFromPath()', async () => {
+      const image = await nativeImage.createFromPathAsync(logoPath);
+      expect(image.getSize()).to.deep.equal({ width: 538, height: 190 });
+      expect(image.toBitmap().equals(nativeImage.createFromPath(logoPath).toBitmap())).to.be.true();
+    });
+
+    it('createFromPathAsync() resolves with an empty image for invalid paths', async () => {
+      expect((await nativeImage.createFromPathAsync('does-not-exist.png')).isEmpty()).to.be.true();
+      expect((await nativeImage.createFromPathAsync(__filename)).isEmpty()).to.be.true();
+    });
+
+    it('createFromBufferAsync() decodes PNG and JPEG data', async () => {
+      const image = nativeImage.createFromPath(logoPath);
+      const fromPNG = await nativeImage.createFromBufferAsync(image.toPNG());
+      expect(fromPNG.getSize()).to.deep.equal({ width: 538, height: 190 });
+      const fromJPEG = await nativeImage.createFromBufferAsync(image.toJPEG(80), { scaleFactor: 2.0 });
+      expect(fromJPEG.getSize()).to.deep.equal({ width: 269, height: 95 });
+    });
+
+    it('createFromBufferAsync() throws for non-buffers', () => {
+      expect(() => nativeImage.createFromBufferAsync(null)).to.throw('buffer must be a node Buffer');
+    });
+
+    it('toPNGAsync() matches toPNG()', async () => {
+      const image = nativeImage.createFromPath(logoPath);
+      expect((await image.toPNGAsync()).equals(image.toPNG())).to.be.true();
+      expect((await image.toPNGAsync({ scaleFactor: 2.0 })).equals(image.toPNG({ scaleFactor: 2.0 }))).to.be.true();
+    });
+
+    it('toJPEGAsync() matches toJPEG()', async () => {
+      const image = nativeImage.createFromPath(logoPath);
+      expect((await image.toJPEGAsync(80)).equals(image.toJPEG(80))).to.be.true();
+    });
+
+    it('toDataURLAsync() matches toDataURL()', async () => {
+      const image = nativeImage.createFromPath(logoPath);
+      expect(await image.toDataURLAsync()).to.equal(image.toDataURL());
+      expect(await image.toDataURLAsync({ scaleFactor: 2.0 })).to.equal(image.toDataURL({ scaleFactor: 2.0 }));
+    });
+
+    it('resizeAsync() returns a resized image', async () => {
+      const image = nativeImage.createFromPath(logoPath);
+      for (const [resizeTo, expectedSize] of new Map([
+        [{}, { width: 538, height: 190 }],
+        [{ width: 269 }, { width: 269, height: 95 }],
+        [{ height: 200 }, { width: 566, height: 200 }],
+        [{ width: 80, height: 65 }, { width: 80, height: 65 }],
+        [{ width: -1, height: -1 }, { width: 0, height: 0 }]
+      ])) {
+        const resized = await image.resizeAsync(resizeTo);
+        expect(resized.getSize()).to.deep.equal(expectedSize);
+      }
+    });
+
+    it('resizeAsync() resolves with an empty image when called on an empty image', async () => {
+      expect((await nativeImage.createEmpty().resizeAsync({ width: 1, height: 1 })).isEmpty()).to.be.true();
+    });
+
+    it('handles many concurrent operations', async () => {
+      const image = nativeImage.createFromPath(logoPath);
+      const results = await Promise.all(Array.from({ length: 32 }, () => image.toPNGAsync({ scaleFactor: 2.0 })));
+      const expected = image.toPNG({ scaleFactor: 2.0 });
+      for (const result of results) {
+        expect(result.equals(expected)).to.be.true();
+      }
+    });
+  });
+
   describe('crop(bounds)', () => {
     it('returns an empty image when called on an empty image', () => {
       expect(nativeImage.createEmpty().crop({ width: 1, height: 2, x: 0, y: 0 }).isEmpty()).to.be.true();
@@ -1,6 +1,7 @@
 const { ipcRenderer } = require('electron');
 const fs = require('fs');
 const path = require('path');
+const zlib = require('zlib');
 
 const { expect } = require('chai');
 
@@ -110,6 +111,19 @@ describe('process module', () => {
       }
     });
 
+    it('gzips the snapshot when asked to', async () => {
+      const filePath = path.join(await ipcRenderer.invoke('get-temp-dir'), 'test.heapsnapshot.gz');
+
+      try {
+        const success = process.takeHeapSnapshot(filePath, { compress: true });
+        expect(success).to.be.true();
+        const snapshot = JSON.parse(zlib.gunzipSync(fs.readFileSync(filePath)).toString());
+        expect(snapshot).to.have.property('nodes');
+      } finally {
+        fs.unlinkSync(filePath);
+      }
+    });
+
     it('returns false on failure', () => {
       const success = process.takeHeapSnapshot('');
       expect(success).to.be.false();
@@ -0,0 +1,10 @@
+// Prints the global defined by snapshot.js, which is only there when the
+// main process was started from the snapshot built from it.
+const { app } = require('electron');
+
+app.whenReady().then(() => {
+  console.log(String(global.snapshotValue));
+  setImmediate(() => {
+    app.exit(0);
+  });
+});
@@ -0,0 +1,3 @@
+// Embedded into browser_v8_snapshot.bin by mksnapshot, so it can only use
+// plain JavaScript.
+var snapshotValue = 'loaded from snapshot'; // eslint-disable-line no-unused-vars
@@ -0,0 +1,23 @@
+const { app } = require('electron');
+const fs = require('fs');
+const net = require('net');
+
+// Every socket is opened from inside a uv callback, and no timer is running
+// that could wake the loop up if the new watchers were missed.
+app.whenReady().then(() => {
+  fs.readFile(__filename, () => {
+    const server = net.createServer(socket => socket.end('pong'));
+    server.listen(0, '127.0.0.1', () => {
+      Promise.resolve().then(() => {
+        const socket = net.connect(server.address().port, '127.0.0.1');
+        let data = '';
+        socket.on('data', chunk => { data += chunk; });
+        socket.on('end', () => {
+          server.close();
+          process.stdout.write(data);
+          app.quit();
+        });
+      });
+    });
+  });
+});
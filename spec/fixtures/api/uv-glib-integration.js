@@ -0,0 +1,22 @@
+const { app } = require('electron');
+const fs = require('fs');
+const net = require('net');
+
+app.whenReady().then(async () => {
+  await new Promise(resolve => setTimeout(resolve, 10));
+  await fs.promises.readFile(__filename);
+
+  const server = net.createServer(socket => socket.end('pong'));
+  await new Promise(resolve => server.listen(0, '127.0.0.1', resolve));
+  const reply = await new Promise((resolve, reject) => {
+    const socket = net.connect(server.address().port, '127.0.0.1');
+    let data = '';
+    socket.on('data', chunk => { data += chunk; });
+    socket.on('end', () => resolve(data));
+    socket.on('error', reject);
+  });
+  server.close();
+
+  process.stdout.write(reply);
+  app.quit();
+});
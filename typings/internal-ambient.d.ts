@@ -1,7 +1,7 @@
 declare var internalBinding: any;
 declare var nodeProcess: any;
 declare var isolatedWorld: any;
-declare var binding: { get: (name: string) => any; process: NodeJS.Process; createPreloadScript: (src: string) => Function };
+declare var binding: { get: (name: string) => any; process: NodeJS.Process; compilePreloadScript: (path: string, src: string, cachedData?: Uint8Array) => { fn: Function, cachedDataRejected?: boolean }; cachedDataVersionTag: number };
 
 declare const BUILDFLAG: (flag: boolean) => boolean;
 
@@ -98,6 +98,10 @@ declare namespace NodeJS {
     session?: Electron.Session;
     partition?: string;
     referrer?: string;
+    responseBufferSize?: number;
+    savePath?: string;
+    redirectPolicy?: 'follow' | 'error' | 'manual';
+    loadOnUIThread?: boolean;
   }
   type ResponseHead = {
     statusCode: number;
@@ -118,7 +122,7 @@ declare namespace NodeJS {
 
   interface URLLoader extends EventEmitter {
     cancel(): void;
-    on(eventName: 'data', listener: (event: any, data: ArrayBuffer) => void): this;
+    on(eventName: 'data', listener: (event: any, data: Uint8Array) => void): this;
     on(eventName: 'response-started', listener: (event: any, finalUrl: string, responseHead: ResponseHead) => void): this;
     on(eventName: 'complete', listener: (event: any) => void): this;
     on(eventName: 'error', listener: (event: any, netErrorString: string) => void): this;
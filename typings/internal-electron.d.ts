@@ -176,6 +176,8 @@ declare namespace Electron {
     setContentView(view: View): void
     static fromId(id: number): BaseWindow;
     static getAllWindows(): BaseWindow[];
+    static _getNextWindow(cursor: number): [BaseWindow, number] | undefined;
+    static _iterateWindows(): IterableIterator<BaseWindow>;
     isFocused(): boolean;
     static getFocusedWindow(): BaseWindow | undefined;
     setMenu(menu: Menu): void;
@@ -224,8 +226,9 @@ declare namespace ElectronInternal {
   }
 
   interface DesktopCapturer {
-    startHandling(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean): void;
+    startHandling(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean, streamSources: boolean): void;
     _onerror?: (error: string) => void;
+    _onsource?: (source: Electron.DesktopCapturerSource) => void;
     _onfinished?: (sources: Electron.DesktopCapturerSource[], fetchWindowIcons: boolean) => void;
   }
 